@@ -0,0 +1,835 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include "alocacao.h"
+#include "cfg.h"
+#include "dominancia.h"
+#include "fluxo.h"
+
+/* Ordem de preferência: o ILOC não tem chamadas, então toda função é folha e
+   os caller-saved vêm primeiro (não custam nada). Os callee-saved só entram
+   sob pressão, e aí precisam ser salvos no prólogo. O %ebp fica por último:
+   só é alocável quando o frame é endereçado por %rsp. */
+const char *reg_fisicos[QTD_REG_FISICOS] = {
+    "%ecx", "%esi", "%edi", "%r8d", "%r9d", "%r10d", "%r11d",
+    "%ebx", "%r12d", "%r13d", "%r14d", "%r15d", "%ebp"
+};
+
+const char *reg_fisicos_64[QTD_REG_FISICOS] = {
+    "%rcx", "%rsi", "%rdi", "%r8", "%r9", "%r10", "%r11",
+    "%rbx", "%r12", "%r13", "%r14", "%r15", "%rbp"
+};
+
+const int reg_callee_saved[QTD_REG_FISICOS] = {
+    0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1
+};
+
+/* ================================================================= */
+/* ==================== FUNÇÕES AUXILIARES ========================= */
+/* ================================================================= */
+
+/* Id de um temporário, ou -1 se for um registrador especial (rfp, rbss...) */
+static int id_temporario(int reg) {
+    return reg >= 0 ? reg : -1;
+}
+
+/* Indica se a base de um loadAI/storeAI é o frame local */
+static int base_local(int base) {
+    return base == REG_RFP;
+}
+
+int vreg_registrador(Alocacao *a, int reg) {
+    int id = id_temporario(reg);
+    if (id < 0 || id >= a->faixa_temps) return -1;
+    return a->vreg_do_temp[id];
+}
+
+int vreg_local(Alocacao *a, int deslocamento) {
+    return a->num_temps + deslocamento / 4;
+}
+
+int deslocamento_spill(Alocacao *a, int vreg) {
+    return a->slot[vreg] * 4 + 4;
+}
+
+/* Registradores virtuais lidos (usos) e escrito (def) por uma operação */
+static void usos_defs_brutos(Alocacao *a, OperacaoILOC *op, int usos[2], int *num_usos, int *def) {
+    *num_usos = 0;
+    *def = -1;
+
+    switch (op->opcode) {
+        case OP_LOADAI:
+            /* loadAI rfp, c => rX lê a variável local c */
+            if (base_local(op->operandos_fonte[0].valor.reg)) {
+                usos[(*num_usos)++] = vreg_local(a, op->operandos_fonte[1].valor.imediato);
+            }
+            *def = vreg_registrador(a, op->operandos_alvo[0].valor.reg);
+            return;
+
+        case OP_STOREAI:
+            /* storeAI rX => rfp, c escreve a variável local c */
+            {
+                int v = vreg_registrador(a, op->operandos_fonte[0].valor.reg);
+                if (v >= 0) usos[(*num_usos)++] = v;
+            }
+            if (base_local(op->operandos_alvo[0].valor.reg)) {
+                *def = vreg_local(a, op->operandos_alvo[1].valor.imediato);
+            }
+            return;
+
+        default:
+            break;
+    }
+
+    for (int i = 0; i < op->num_fonte && *num_usos < 2; i++) {
+        if (op->operandos_fonte[i].tipo != OPERAND_REGISTER) continue;
+        int v = vreg_registrador(a, op->operandos_fonte[i].valor.reg);
+        if (v >= 0) usos[(*num_usos)++] = v;
+    }
+    for (int i = 0; i < op->num_alvo; i++) {
+        if (op->operandos_alvo[i].tipo != OPERAND_REGISTER) continue;
+        int v = vreg_registrador(a, op->operandos_alvo[i].valor.reg);
+        if (v < 0) continue;
+        /* store rX => rY não escreve rY, usa-o como endereço */
+        if (op->opcode == OP_STORE) {
+            if (*num_usos < 2) usos[(*num_usos)++] = v;
+        } else {
+            *def = v;
+        }
+    }
+}
+
+/* Idem, ignorando os vregs rematerializáveis, que não disputam registradores */
+static void usos_defs(Alocacao *a, OperacaoILOC *op, int usos[2], int *num_usos, int *def) {
+    int brutos[2], num_brutos;
+    usos_defs_brutos(a, op, brutos, &num_brutos, def);
+
+    *num_usos = 0;
+    for (int k = 0; k < num_brutos; k++) {
+        if (!a->rematerializavel[brutos[k]]) usos[(*num_usos)++] = brutos[k];
+    }
+    if (*def >= 0 && a->rematerializavel[*def]) *def = -1;
+}
+
+/* Identifica cópias entre vregs: i2i e loadAI/storeAI de variável local */
+static int eh_copia(Alocacao *a, OperacaoILOC *op, int *origem, int *destino) {
+    int usos[2], num_usos, dv;
+    if (op->opcode != OP_I2I && op->opcode != OP_LOADAI && op->opcode != OP_STOREAI) return 0;
+    usos_defs(a, op, usos, &num_usos, &dv);
+    if (num_usos != 1 || dv < 0) return 0;
+    *origem = usos[0];
+    *destino = dv;
+    return 1;
+}
+
+/* Marca os temporários cuja única definição é um loadI: em vez de ocupar
+   registrador ou slot, a constante é reemitida como imediato em cada uso.
+   O divisor de div fica de fora, pois idivl não aceita imediato. */
+static void marcar_rematerializaveis(Alocacao *a, FuncaoILOC *f) {
+    int *num_defs = (int*)calloc(a->num_vregs + 1, sizeof(int));
+
+    for (int i = 0; i < f->num_ops; i++) {
+        OperacaoILOC *op = &f->ops[i];
+        int usos[2], num_usos, dv;
+        usos_defs_brutos(a, op, usos, &num_usos, &dv);
+        if (dv < 0) continue;
+        num_defs[dv]++;
+        if (op->opcode == OP_LOADI && dv < a->num_temps) {
+            a->valor_constante[dv] = op->operandos_fonte[0].valor.imediato;
+        }
+    }
+
+    for (int v = 0; v < a->num_temps; v++) a->rematerializavel[v] = (num_defs[v] == 1);
+    for (int i = 0; i < f->num_ops; i++) {
+        OperacaoILOC *op = &f->ops[i];
+        int usos[2], num_usos, dv;
+        usos_defs_brutos(a, op, usos, &num_usos, &dv);
+        if (dv >= 0 && op->opcode != OP_LOADI) a->rematerializavel[dv] = 0;
+        if (op->opcode == OP_DIV) {
+            int divisor = vreg_registrador(a, op->operandos_fonte[1].valor.reg);
+            if (divisor >= 0) a->rematerializavel[divisor] = 0;
+        }
+    }
+
+    free(num_defs);
+}
+
+/* Descobre a faixa de temporários e de locais usados pela função */
+static void dimensionar_vregs(Alocacao *a, FuncaoILOC *f) {
+    int max_local = -1;
+
+    for (int i = 0; i < f->num_ops; i++) {
+        OperacaoILOC *op = &f->ops[i];
+        if (op->opcode == OP_LOADAI && base_local(op->operandos_fonte[0].valor.reg)) {
+            int d = op->operandos_fonte[1].valor.imediato / 4;
+            if (d > max_local) max_local = d;
+        }
+        if (op->opcode == OP_STOREAI && base_local(op->operandos_alvo[0].valor.reg)) {
+            int d = op->operandos_alvo[1].valor.imediato / 4;
+            if (d > max_local) max_local = d;
+        }
+    }
+
+    a->faixa_temps = faixa_temporarios(f);
+
+    // Numera densamente os temporários que ainda aparecem: os passes de
+    // otimização apagam operações e deixam buracos na numeração da função
+    a->vreg_do_temp = (int*)malloc((a->faixa_temps + 1) * sizeof(int));
+    for (int t = 0; t < a->faixa_temps; t++) a->vreg_do_temp[t] = -1;
+    for (int i = 0; i < f->num_ops; i++) {
+        OperacaoILOC *op = &f->ops[i];
+        for (int j = 0; j < op->num_fonte; j++) {
+            int id = id_temporario(op->operandos_fonte[j].valor.reg);
+            if (op->operandos_fonte[j].tipo == OPERAND_REGISTER && id >= 0) a->vreg_do_temp[id] = 0;
+        }
+        for (int j = 0; j < op->num_alvo; j++) {
+            int id = id_temporario(op->operandos_alvo[j].valor.reg);
+            if (op->operandos_alvo[j].tipo == OPERAND_REGISTER && id >= 0) a->vreg_do_temp[id] = 0;
+        }
+    }
+    a->num_temps = 0;
+    for (int t = 0; t < a->faixa_temps; t++) {
+        if (a->vreg_do_temp[t] == 0) a->vreg_do_temp[t] = a->num_temps++;
+    }
+    a->num_vregs = a->num_temps + max_local + 1;
+}
+
+/* ================================================================= */
+/* ========================= VIVACIDADE ============================ */
+/* ================================================================= */
+
+/* Blocos da função e os conjuntos de vregs vivos na entrada/saída de cada um.
+   Só vregs lidos em algum bloco antes de serem escritos nele podem estar vivos
+   numa fronteira de bloco; os conjuntos usam índices compactos só para eles. */
+typedef struct vivacidade {
+    CFG *cfg;
+    ProblemaFluxo *fluxo;
+    BlocoBasico *blocos;
+    int num_blocos;
+    int palavras;       // Palavras de 64 bits por conjunto (compacto)
+    uint64_t *in;
+    uint64_t *out;
+    int *vreg_global;   // Por índice compacto: o vreg correspondente
+} Vivacidade;
+
+/* Vivacidade é um problema para trás com união: gen = use (lido antes de
+   escrito no bloco), kill = def */
+static Vivacidade* calcular_vivacidade(Alocacao *a, FuncaoILOC *f) {
+    Vivacidade *viv = (Vivacidade*)malloc(sizeof(Vivacidade));
+    viv->cfg = construir_cfg(f);
+    viv->blocos = viv->cfg->blocos;
+    viv->num_blocos = viv->cfg->num_blocos;
+    BlocoBasico *blocos = viv->blocos;
+
+    // Numera os vregs expostos na entrada de algum bloco
+    int *indice = (int*)malloc((a->num_vregs + 1) * sizeof(int));
+    int *escrito_em = (int*)malloc((a->num_vregs + 1) * sizeof(int));
+    viv->vreg_global = (int*)malloc((a->num_vregs + 1) * sizeof(int));
+    int num_globais = 0;
+    for (int v = 0; v < a->num_vregs; v++) indice[v] = escrito_em[v] = -1;
+    for (int b = 0; b < viv->num_blocos; b++) {
+        for (int i = blocos[b].inicio; i <= blocos[b].fim; i++) {
+            int usos[2], num_usos, dv;
+            usos_defs(a, &f->ops[i], usos, &num_usos, &dv);
+            for (int k = 0; k < num_usos; k++) {
+                int v = usos[k];
+                if (escrito_em[v] != b && indice[v] < 0) {
+                    indice[v] = num_globais;
+                    viv->vreg_global[num_globais++] = v;
+                }
+            }
+            if (dv >= 0) escrito_em[dv] = b;
+        }
+    }
+
+    ProblemaFluxo *p = criar_problema_fluxo(viv->cfg, num_globais, FLUXO_PARA_TRAS, CONFLUENCIA_UNIAO);
+    for (int b = 0; b < viv->num_blocos; b++) {
+        uint64_t *u = CONJUNTO(p, gen, b), *d = CONJUNTO(p, kill, b);
+        for (int i = blocos[b].inicio; i <= blocos[b].fim; i++) {
+            int usos[2], num_usos, dv;
+            usos_defs(a, &f->ops[i], usos, &num_usos, &dv);
+            for (int k = 0; k < num_usos; k++) {
+                int g = indice[usos[k]];
+                if (g >= 0 && !BIT_TEST(d, g)) BIT_SET(u, g);
+            }
+            if (dv >= 0 && indice[dv] >= 0) BIT_SET(d, indice[dv]);
+        }
+    }
+    resolver_fluxo(p);
+
+    free(escrito_em);
+    free(indice);
+    viv->fluxo = p;
+    viv->palavras = p->palavras;
+    viv->in = p->in;
+    viv->out = p->out;
+    return viv;
+}
+
+static void liberar_vivacidade(Vivacidade *viv) {
+    liberar_problema_fluxo(viv->fluxo);
+    liberar_cfg(viv->cfg);
+    free(viv->vreg_global);
+    free(viv);
+}
+
+/* Calcula os intervalos de vida de todos os vregs da função.
+   Cada operação i ocupa duas posições: 2i (leitura) e 2i+1 (escrita), de modo
+   que um valor lido pela última vez em i pode ceder o registrador ao escrito em i. */
+static Intervalo* calcular_intervalos(Alocacao *a, FuncaoILOC *f) {
+    Vivacidade *viv = calcular_vivacidade(a, f);
+    BlocoBasico *blocos = viv->blocos;
+    int palavras = viv->palavras;
+
+    Intervalo *intervalos = (Intervalo*)malloc((a->num_vregs + 1) * sizeof(Intervalo));
+    for (int v = 0; v < a->num_vregs; v++) {
+        intervalos[v].vreg = v;
+        intervalos[v].inicio = INT_MAX;
+        intervalos[v].fim = -1;
+    }
+
+#define ESTENDER(v, p) do { \
+        if ((p) < intervalos[v].inicio) intervalos[v].inicio = (p); \
+        if ((p) > intervalos[v].fim) intervalos[v].fim = (p); \
+    } while (0)
+
+    for (int b = 0; b < viv->num_blocos; b++) {
+        uint64_t *n = viv->in + (size_t)b * palavras, *o = viv->out + (size_t)b * palavras;
+        for (int w = 0; w < palavras; w++) {
+            for (uint64_t bits = n[w]; bits; bits &= bits - 1) {
+                ESTENDER(viv->vreg_global[w * 64 + __builtin_ctzll(bits)], 2 * blocos[b].inicio);
+            }
+            for (uint64_t bits = o[w]; bits; bits &= bits - 1) {
+                ESTENDER(viv->vreg_global[w * 64 + __builtin_ctzll(bits)], 2 * blocos[b].fim + 1);
+            }
+        }
+        for (int i = blocos[b].inicio; i <= blocos[b].fim; i++) {
+            int usos[2], num_usos, dv;
+            usos_defs(a, &f->ops[i], usos, &num_usos, &dv);
+            for (int k = 0; k < num_usos; k++) ESTENDER(usos[k], 2 * i);
+            if (dv >= 0) ESTENDER(dv, 2 * i + 1);
+        }
+    }
+#undef ESTENDER
+
+    liberar_vivacidade(viv);
+    return intervalos;
+}
+
+/* ================================================================= */
+/* ====================== SLOTS DE PILHA =========================== */
+/* ================================================================= */
+
+/* Slots para os intervalos em spill (ordenados por início). Um slot fica livre
+   quando o intervalo que o ocupava termina, então temporários e locais que não
+   estão vivos ao mesmo tempo dividem a mesma posição do frame. */
+static void atribuir_slots_intervalos(Alocacao *a, Intervalo *intervalos, int n, int *preferido) {
+    int *fim_slot = (int*)malloc((n + 1) * sizeof(int));
+
+    for (int v = 0; v < a->num_vregs; v++) a->slot[v] = -1;
+    a->num_slots = 0;
+
+    for (int i = 0; i < n; i++) {
+        Intervalo *it = &intervalos[i];
+        if (a->reg[it->vreg] >= 0) continue;
+
+        // O slot da origem da cópia, se já está livre; senão o menor slot
+        // livre, para manter o frame compacto
+        int p = preferido[it->vreg];
+        int s = (p >= 0) ? a->slot[p] : -1;
+        if (s < 0 || fim_slot[s] >= it->inicio) {
+            s = 0;
+            while (s < a->num_slots && fim_slot[s] >= it->inicio) s++;
+        }
+        if (s == a->num_slots) a->num_slots++;
+
+        fim_slot[s] = it->fim;
+        a->slot[it->vreg] = s;
+    }
+
+    free(fim_slot);
+}
+
+/* ================================================================= */
+/* ====================== VARREDURA LINEAR ========================= */
+/* ================================================================= */
+
+static int comparar_inicio(const void *x, const void *y) {
+    const Intervalo *a = (const Intervalo*)x, *b = (const Intervalo*)y;
+    if (a->inicio != b->inicio) return (a->inicio < b->inicio) ? -1 : 1;
+    return a->vreg - b->vreg;
+}
+
+/* Por vreg: origem de uma cópia que o define, ou -1. Se a origem morre na
+   cópia, o destino herda o registrador (ou o slot) dela e a cópia some. */
+static int* origens_de_copias(Alocacao *a, FuncaoILOC *funcao) {
+    int *preferido = (int*)malloc((a->num_vregs + 1) * sizeof(int));
+    for (int v = 0; v < a->num_vregs; v++) preferido[v] = -1;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        int origem, destino;
+        if (eh_copia(a, &funcao->ops[i], &origem, &destino)) preferido[destino] = origem;
+    }
+    return preferido;
+}
+
+static void varredura_linear(Alocacao *a, FuncaoILOC *funcao) {
+    Intervalo *intervalos = calcular_intervalos(a, funcao);
+    int *preferido = origens_de_copias(a, funcao);
+
+    // Descarta vregs que não aparecem e ordena por início
+    int n = 0;
+    for (int v = 0; v < a->num_vregs; v++) {
+        if (intervalos[v].fim >= 0) intervalos[n++] = intervalos[v];
+    }
+    qsort(intervalos, n, sizeof(Intervalo), comparar_inicio);
+
+    // Ativos ordenados por fim crescente
+    Intervalo ativos[QTD_REG_FISICOS];
+    int num_ativos = 0;
+    int livre[QTD_REG_FISICOS];
+    for (int r = 0; r < QTD_REG_FISICOS; r++) livre[r] = r < a->num_fisicos;
+
+    for (int i = 0; i < n; i++) {
+        Intervalo atual = intervalos[i];
+
+        // Expira os intervalos que terminaram antes do início do atual
+        int k = 0;
+        while (k < num_ativos && ativos[k].fim < atual.inicio) {
+            livre[a->reg[ativos[k].vreg]] = 1;
+            k++;
+        }
+        memmove(ativos, ativos + k, (num_ativos - k) * sizeof(Intervalo));
+        num_ativos -= k;
+
+        int escolhido = -1;
+        int p = preferido[atual.vreg];
+        if (p >= 0 && a->reg[p] >= 0 && livre[a->reg[p]]) escolhido = a->reg[p];
+        for (int r = 0; r < QTD_REG_FISICOS && escolhido < 0; r++) {
+            if (livre[r]) escolhido = r;
+        }
+
+        if (escolhido < 0) {
+            // Sem registrador: vai para a pilha quem termina mais tarde
+            Intervalo *ultimo = &ativos[num_ativos - 1];
+            if (ultimo->fim > atual.fim) {
+                escolhido = a->reg[ultimo->vreg];
+                a->reg[ultimo->vreg] = -1;
+                num_ativos--;
+            } else {
+                continue;
+            }
+        }
+
+        a->reg[atual.vreg] = escolhido;
+        livre[escolhido] = 0;
+
+        // Insere mantendo a ordem por fim
+        int pos = num_ativos;
+        while (pos > 0 && ativos[pos - 1].fim > atual.fim) {
+            ativos[pos] = ativos[pos - 1];
+            pos--;
+        }
+        ativos[pos] = atual;
+        num_ativos++;
+    }
+
+    atribuir_slots_intervalos(a, intervalos, n, preferido);
+    free(preferido);
+    free(intervalos);
+}
+
+/* ================================================================= */
+/* ================= COLORAÇÃO DE GRAFO (BRIGGS) =================== */
+/* ================================================================= */
+
+/* Grafo de interferência com matriz de bits (consulta) e listas (iteração).
+   Após uma coalescência, só as linhas dos representantes ficam completas. */
+typedef struct grafo {
+    int n;
+    int k;              // Cores disponíveis (registradores alocáveis)
+    int palavras;       // Palavras por linha da matriz
+    uint64_t *matriz;
+    int **adj;
+    int *num_adj;
+    int *cap_adj;
+    int *grau;
+    int *alias;         // Union-find das coalescências
+    double *custo;      // Custo de spill (ponderado pela profundidade de laço)
+    int *aparece;       // Vreg usado na função
+    int *marca;         // Carimbo para deduplicar vizinhos
+    int carimbo;
+} Grafo;
+
+static int representante(Grafo *g, int v) {
+    while (g->alias[v] != v) {
+        g->alias[v] = g->alias[g->alias[v]];
+        v = g->alias[v];
+    }
+    return v;
+}
+
+static int interfere(Grafo *g, int u, int v) {
+    return BIT_TEST(g->matriz + (size_t)u * g->palavras, v);
+}
+
+static void adicionar_vizinho(Grafo *g, int u, int v) {
+    if (g->num_adj[u] == g->cap_adj[u]) {
+        g->cap_adj[u] = g->cap_adj[u] ? g->cap_adj[u] * 2 : 8;
+        g->adj[u] = (int*)realloc(g->adj[u], g->cap_adj[u] * sizeof(int));
+    }
+    g->adj[u][g->num_adj[u]++] = v;
+}
+
+static void adicionar_aresta(Grafo *g, int u, int v) {
+    if (u == v || interfere(g, u, v)) return;
+    BIT_SET(g->matriz + (size_t)u * g->palavras, v);
+    BIT_SET(g->matriz + (size_t)v * g->palavras, u);
+    adicionar_vizinho(g, u, v);
+    adicionar_vizinho(g, v, u);
+    g->grau[u]++;
+    g->grau[v]++;
+}
+
+/* Profundidade de laço de cada operação: a do seu bloco na floresta de laços naturais */
+static int* profundidade_lacos(FuncaoILOC *f, CFG *cfg) {
+    int *prof = (int*)calloc(f->num_ops + 1, sizeof(int));
+    Dominancia *dom = calcular_dominancia(cfg);
+    FlorestaLacos *lacos = calcular_lacos(cfg, dom);
+
+    for (int i = 0; i < f->num_ops; i++) prof[i] = lacos->profundidade[cfg->bloco_da_op[i]];
+
+    liberar_lacos(lacos);
+    liberar_dominancia(dom);
+    return prof;
+}
+
+static Grafo* construir_grafo(Alocacao *a, FuncaoILOC *f, int **copias, int *num_copias) {
+    int n = a->num_vregs;
+    Grafo *g = (Grafo*)calloc(1, sizeof(Grafo));
+    g->n = n;
+    g->k = a->num_fisicos;
+    g->palavras = (n + 63) / 64;
+    if (g->palavras == 0) g->palavras = 1;
+    g->matriz = (uint64_t*)calloc((size_t)n * g->palavras + 1, sizeof(uint64_t));
+    g->adj = (int**)calloc(n + 1, sizeof(int*));
+    g->num_adj = (int*)calloc(n + 1, sizeof(int));
+    g->cap_adj = (int*)calloc(n + 1, sizeof(int));
+    g->grau = (int*)calloc(n + 1, sizeof(int));
+    g->alias = (int*)malloc((n + 1) * sizeof(int));
+    g->custo = (double*)calloc(n + 1, sizeof(double));
+    g->aparece = (int*)calloc(n + 1, sizeof(int));
+    g->marca = (int*)calloc(n + 1, sizeof(int));
+    for (int v = 0; v < n; v++) g->alias[v] = v;
+
+    Vivacidade *viv = calcular_vivacidade(a, f);
+    int *prof = profundidade_lacos(f, viv->cfg);
+    int palavras = palavras_conjunto(n);
+    uint64_t *vivos = (uint64_t*)malloc((palavras + 1) * sizeof(uint64_t));
+    int cap_copias = 16;
+    *copias = (int*)malloc(2 * cap_copias * sizeof(int));
+    *num_copias = 0;
+
+    for (int b = 0; b < viv->num_blocos; b++) {
+        memset(vivos, 0, palavras * sizeof(uint64_t));
+        uint64_t *out = viv->out + (size_t)b * viv->palavras;
+        for (int w = 0; w < viv->palavras; w++) {
+            for (uint64_t bits = out[w]; bits; bits &= bits - 1) {
+                BIT_SET(vivos, viv->vreg_global[w * 64 + __builtin_ctzll(bits)]);
+            }
+        }
+
+        // Percorre o bloco de trás para frente mantendo o conjunto de vivos
+        for (int i = viv->blocos[b].fim; i >= viv->blocos[b].inicio; i--) {
+            OperacaoILOC *op = &f->ops[i];
+            int usos[2], num_usos, dv, origem, destino;
+            usos_defs(a, op, usos, &num_usos, &dv);
+
+            // Cada ocorrência custa mais quanto mais aninhado o laço
+            double peso = 1.0;
+            for (int k = 0; k < prof[i] && k < 8; k++) peso *= 10.0;
+            for (int k = 0; k < num_usos; k++) {
+                g->custo[usos[k]] += peso;
+                g->aparece[usos[k]] = 1;
+            }
+            if (dv >= 0) {
+                g->custo[dv] += peso;
+                g->aparece[dv] = 1;
+            }
+
+            // Origem e destino de uma cópia não interferem entre si
+            if (eh_copia(a, op, &origem, &destino)) {
+                BIT_CLR(vivos, origem);
+                if (*num_copias == cap_copias) {
+                    cap_copias *= 2;
+                    *copias = (int*)realloc(*copias, 2 * cap_copias * sizeof(int));
+                }
+                (*copias)[2 * *num_copias] = origem;
+                (*copias)[2 * *num_copias + 1] = destino;
+                (*num_copias)++;
+            }
+
+            if (dv >= 0) {
+                for (int w = 0; w < palavras; w++) {
+                    for (uint64_t bits = vivos[w]; bits; bits &= bits - 1) {
+                        adicionar_aresta(g, dv, w * 64 + __builtin_ctzll(bits));
+                    }
+                }
+                BIT_CLR(vivos, dv);
+            }
+            for (int k = 0; k < num_usos; k++) BIT_SET(vivos, usos[k]);
+        }
+    }
+
+    free(vivos);
+    free(prof);
+    liberar_vivacidade(viv);
+    return g;
+}
+
+static void liberar_grafo(Grafo *g) {
+    for (int v = 0; v < g->n; v++) free(g->adj[v]);
+    free(g->adj);
+    free(g->num_adj);
+    free(g->cap_adj);
+    free(g->grau);
+    free(g->alias);
+    free(g->custo);
+    free(g->aparece);
+    free(g->matriz);
+    free(g->marca);
+    free(g);
+}
+
+/* Teste conservador de Briggs: o nó unido deve ter menos de K vizinhos de grau >= K */
+static int teste_briggs(Grafo *g, int u, int v) {
+    int significativos = 0;
+    int nos[2] = {u, v};
+    g->carimbo++;
+
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < g->num_adj[nos[k]]; j++) {
+            int w = representante(g, g->adj[nos[k]][j]);
+            if (w == u || w == v || g->marca[w] == g->carimbo) continue;
+            g->marca[w] = g->carimbo;
+            // Um vizinho comum aos dois perde uma aresta com a união
+            int grau = g->grau[w] - ((interfere(g, w, u) && interfere(g, w, v)) ? 1 : 0);
+            if (grau >= g->k && ++significativos >= g->k) return 0;
+        }
+    }
+    return 1;
+}
+
+/* Teste de George: todo vizinho significativo de v já interfere com u.
+   Só percorre os vizinhos de v, então é barato quando v tem grau pequeno. */
+static int teste_george(Grafo *g, int u, int v) {
+    for (int j = 0; j < g->num_adj[v]; j++) {
+        int w = representante(g, g->adj[v][j]);
+        if (w == u || w == v) continue;
+        if (g->grau[w] >= g->k && !interfere(g, w, u)) return 0;
+    }
+    return 1;
+}
+
+static int pode_coalescer(Grafo *g, int u, int v) {
+    return teste_george(g, u, v) || teste_briggs(g, u, v);
+}
+
+/* Une v em u */
+static void coalescer(Grafo *g, int u, int v) {
+    g->alias[v] = u;
+    g->custo[u] += g->custo[v];
+    g->carimbo++;
+
+    for (int j = 0; j < g->num_adj[v]; j++) {
+        int w = representante(g, g->adj[v][j]);
+        if (w == u || g->marca[w] == g->carimbo) continue;
+        g->marca[w] = g->carimbo;
+        if (interfere(g, u, w)) {
+            g->grau[w]--;
+        } else {
+            // w troca o vizinho v por u: o grau de w não muda
+            BIT_SET(g->matriz + (size_t)u * g->palavras, w);
+            BIT_SET(g->matriz + (size_t)w * g->palavras, u);
+            adicionar_vizinho(g, u, w);
+            adicionar_vizinho(g, w, u);
+            g->grau[u]++;
+        }
+    }
+}
+
+/* Coloração dos nós em spill com slots do frame: dois representantes só
+   dividem um slot se não interferem. Membros de um grupo coalescido usam o
+   slot do representante, então a cópia entre eles também desaparece. */
+static void atribuir_slots_grafo(Alocacao *a, Grafo *g) {
+    int *ocupado = (int*)calloc(g->n + 1, sizeof(int));
+    int carimbo = 0;
+
+    for (int v = 0; v < g->n; v++) a->slot[v] = -1;
+    a->num_slots = 0;
+
+    for (int v = 0; v < g->n; v++) {
+        if (!g->aparece[v] || a->reg[v] >= 0) continue;
+        int r = representante(g, v);
+
+        if (a->slot[r] < 0) {
+            carimbo++;
+            for (int j = 0; j < g->num_adj[r]; j++) {
+                int w = representante(g, g->adj[r][j]);
+                if (a->slot[w] >= 0) ocupado[a->slot[w]] = carimbo;
+            }
+            int s = 0;
+            while (s < a->num_slots && ocupado[s] == carimbo) s++;
+            if (s == a->num_slots) a->num_slots++;
+            a->slot[r] = s;
+        }
+        a->slot[v] = a->slot[r];
+    }
+
+    free(ocupado);
+}
+
+static void colorir_grafo(Alocacao *a, FuncaoILOC *funcao) {
+    int *copias, num_copias;
+    Grafo *g = construir_grafo(a, funcao, &copias, &num_copias);
+    int n = g->n;
+
+    // Coalescência conservadora das cópias, repetida até estabilizar
+    int mudou = 1;
+    while (mudou) {
+        mudou = 0;
+        for (int c = 0; c < num_copias; c++) {
+            int u = representante(g, copias[2 * c]);
+            int v = representante(g, copias[2 * c + 1]);
+            if (u == v || interfere(g, u, v)) continue;
+
+            // Une o nó de lista menor ao de lista maior (união mais barata)
+            if (g->num_adj[v] > g->num_adj[u]) {
+                int t = u; u = v; v = t;
+            }
+            if (pode_coalescer(g, u, v)) {
+                coalescer(g, u, v);
+                mudou = 1;
+            }
+        }
+    }
+
+    // Simplificação: remove nós de grau < K; se não houver, escolhe o de
+    // menor custo/grau como candidato a spill (coloração otimista)
+    int *grau = (int*)malloc((n + 1) * sizeof(int));
+    int *removido = (int*)calloc(n + 1, sizeof(int));
+    int *pilha = (int*)malloc((n + 1) * sizeof(int));
+    int *baixo = (int*)malloc((n + 1) * sizeof(int));
+    int topo = 0, num_baixo = 0, restantes = 0;
+
+    for (int v = 0; v < n; v++) {
+        if (!g->aparece[v] || representante(g, v) != v) {
+            removido[v] = 1;
+            continue;
+        }
+        grau[v] = g->grau[v];
+        restantes++;
+        if (grau[v] < g->k) baixo[num_baixo++] = v;
+    }
+
+    while (restantes > 0) {
+        int v = -1;
+        while (num_baixo > 0) {
+            int c = baixo[--num_baixo];
+            if (!removido[c]) { v = c; break; }
+        }
+        if (v < 0) {
+            double melhor = 0;
+            for (int c = 0; c < n; c++) {
+                if (removido[c]) continue;
+                double razao = g->custo[c] / (grau[c] + 1);
+                if (v < 0 || razao < melhor) { v = c; melhor = razao; }
+            }
+        }
+
+        removido[v] = 1;
+        pilha[topo++] = v;
+        restantes--;
+
+        g->carimbo++;
+        for (int j = 0; j < g->num_adj[v]; j++) {
+            int w = representante(g, g->adj[v][j]);
+            if (removido[w] || g->marca[w] == g->carimbo) continue;
+            g->marca[w] = g->carimbo;
+            if (--grau[w] == g->k - 1) baixo[num_baixo++] = w;
+        }
+    }
+
+    // Seleção: desempilha e pinta com a primeira cor livre entre os vizinhos
+    int *cor = (int*)malloc((n + 1) * sizeof(int));
+    for (int v = 0; v < n; v++) cor[v] = -1;
+
+    while (topo > 0) {
+        int v = pilha[--topo];
+        int usada[QTD_REG_FISICOS] = {0};
+        for (int j = 0; j < g->num_adj[v]; j++) {
+            int w = representante(g, g->adj[v][j]);
+            if (cor[w] >= 0) usada[cor[w]] = 1;
+        }
+        for (int r = 0; r < g->k; r++) {
+            if (!usada[r]) { cor[v] = r; break; }
+        }
+    }
+
+    for (int v = 0; v < n; v++) a->reg[v] = cor[representante(g, v)];
+
+    atribuir_slots_grafo(a, g);
+
+    free(cor);
+    free(grau);
+    free(removido);
+    free(pilha);
+    free(baixo);
+    free(copias);
+    liberar_grafo(g);
+}
+
+/* ================================================================= */
+/* ======================== FUNÇÃO PRINCIPAL ======================= */
+/* ================================================================= */
+
+Alocacao* alocar_registradores(FuncaoILOC *funcao, ModoAlocacao modo, int usar_rbp) {
+    Alocacao *a = (Alocacao*)calloc(1, sizeof(Alocacao));
+    a->num_fisicos = usar_rbp ? QTD_REG_FISICOS : QTD_REG_FISICOS - 1;
+    dimensionar_vregs(a, funcao);
+
+    a->reg = (int*)malloc((a->num_vregs + 1) * sizeof(int));
+    a->slot = (int*)malloc((a->num_vregs + 1) * sizeof(int));
+    a->rematerializavel = (int*)calloc(a->num_vregs + 1, sizeof(int));
+    a->valor_constante = (int*)calloc(a->num_vregs + 1, sizeof(int));
+    for (int v = 0; v < a->num_vregs; v++) a->reg[v] = -1;
+
+    marcar_rematerializaveis(a, funcao);
+
+    if (modo == ALOC_GRAFO) {
+        colorir_grafo(a, funcao);
+    } else {
+        varredura_linear(a, funcao);
+    }
+
+    // Registradores físicos que o corpo da função escreve
+    for (int i = 0; i < funcao->num_ops; i++) {
+        int usos[2], num_usos, dv;
+        usos_defs(a, &funcao->ops[i], usos, &num_usos, &dv);
+        if (dv >= 0 && a->reg[dv] >= 0) a->escritos[a->reg[dv]] = 1;
+    }
+
+    return a;
+}
+
+void liberar_alocacao(Alocacao *a) {
+    if (!a) return;
+    free(a->reg);
+    free(a->slot);
+    free(a->rematerializavel);
+    free(a->valor_constante);
+    free(a->vreg_do_temp);
+    free(a);
+}
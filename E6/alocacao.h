@@ -0,0 +1,76 @@
+#ifndef _ALOCACAO_H_
+#define _ALOCACAO_H_
+
+#include "iloc.h"
+
+/* ============================================== */
+/* =========== REGISTRADORES FÍSICOS ============ */
+/* ============================================== */
+
+/* %eax e %edx ficam de fora: são os registradores de rascunho usados
+   pelos templates de tradução (e por cltd/idivl na divisão).
+   O último (%ebp) só entra no pool quando o frame pointer é omitido. */
+#define QTD_REG_FISICOS 13
+
+/* Nomes de 32 bits (operações) e de 64 bits (push/pop), em ordem de preferência */
+extern const char *reg_fisicos[QTD_REG_FISICOS];
+extern const char *reg_fisicos_64[QTD_REG_FISICOS];
+
+/* 1 se o registrador precisa ser preservado pela função chamada */
+extern const int reg_callee_saved[QTD_REG_FISICOS];
+
+/* ============================================== */
+/* ========== ESTRUTURAS DA ALOCAÇÃO ============ */
+/* ============================================== */
+
+/* Estratégia de alocação */
+typedef enum {
+    ALOC_LINEAR = 0,    // Varredura linear: rápida, boa o bastante no geral
+    ALOC_GRAFO          // Coloração de grafo (Chaitin-Briggs) com coalescência: -O2
+} ModoAlocacao;
+
+/* Intervalo de vida de um registrador virtual (posições na ordem linear) */
+typedef struct intervalo {
+    int vreg;
+    int inicio;
+    int fim;
+} Intervalo;
+
+/* Resultado da alocação de registradores de uma função.
+   Registradores virtuais (vregs) são os temporários rN da função seguidos
+   das variáveis locais (rfp + deslocamento), que também disputam registradores. */
+typedef struct alocacao {
+    int faixa_temps;    // Ids de temporários da função: [0, faixa_temps)
+    int *vreg_do_temp;  // Por id: vreg do temporário, ou -1 se não aparece
+    int num_temps;      // Temporários distintos usados na função
+    int num_vregs;      // Temporários + variáveis locais
+    int num_fisicos;    // Registradores alocáveis (os primeiros de reg_fisicos)
+    int *reg;           // Por vreg: índice em reg_fisicos, ou -1 se está na pilha
+    int *slot;          // Por vreg em spill: slot de 4 bytes no frame da função
+    int num_slots;      // Slots usados pela função
+    int escritos[QTD_REG_FISICOS];  // Registradores físicos escritos pela função
+    int *rematerializavel;  // Por vreg: 1 se é uma constante reemitida em cada uso
+    int *valor_constante;   // Valor da constante, quando rematerializável
+} Alocacao;
+
+/* ============================================== */
+/* ============ FUNÇÕES DA ALOCAÇÃO ============= */
+/* ============================================== */
+
+/* Vreg de um operando registrador (-1 para rfp, rbss e afins) */
+int vreg_registrador(Alocacao *a, int reg);
+
+/* Vreg da variável local no deslocamento informado */
+int vreg_local(Alocacao *a, int deslocamento);
+
+/* Deslocamento (abaixo de %rbp) do slot de pilha de um vreg em spill */
+int deslocamento_spill(Alocacao *a, int vreg);
+
+/* Aloca registradores para a função com a estratégia escolhida.
+   Com usar_rbp, %ebp também entra no pool (frame endereçado por %rsp). */
+Alocacao* alocar_registradores(FuncaoILOC *funcao, ModoAlocacao modo, int usar_rbp);
+
+/* Libera a alocação */
+void liberar_alocacao(Alocacao *a);
+
+#endif // _ALOCACAO_H_
@@ -5,7 +5,7 @@
 #include "tipos.h"
 #include "iloc.h"
 
-asd_tree_t *asd_new(const char *label, TipoDados data_type, int num_linha, char *temp, ListaILOC *codigo)
+asd_tree_t *asd_new(const char *label, TipoDados data_type, int num_linha, int temp, ListaILOC *codigo)
 {
   asd_tree_t *ret = NULL;
   ret = calloc(1, sizeof(asd_tree_t));
@@ -16,11 +16,7 @@ asd_tree_t *asd_new(const char *label, TipoDados data_type, int num_linha, char
     ret->num_linha = num_linha;
     ret->children = NULL;
 
-    if(temp != NULL){
-      ret->temp = strdup(temp);
-    }else{
-      ret->temp = NULL;
-    }
+    ret->temp = temp;
 
     ret->codigo = codigo; // Recebe endereço do pedaço de código (ou NULL)
 
@@ -37,7 +33,6 @@ void asd_free(asd_tree_t *tree)
     }
     free(tree->children);
     free(tree->label);
-    free(tree->temp);
     if(tree->codigo != NULL)liberar_lista_iloc(tree->codigo); // chama função para liberação da lista
     free(tree);
   }else{
@@ -11,7 +11,7 @@ typedef struct asd_tree {
   int num_linha;
   struct asd_tree **children;
 
-  char *temp;         // Ex: "r1", "r2". O registrador que guarda o valor deste nó.
+  int temp;           // Id do registrador que guarda o valor deste nó (REG_NENHUM se não há).
   ListaILOC *codigo;  // A lista de instruções ILOC gerada por este nó e seus filhos.
   
   struct asd_tree *filho_1;
@@ -21,7 +21,7 @@ typedef struct asd_tree {
 /*
  * Função asd_new, cria um nó sem filhos com o label informado.
  */
-asd_tree_t *asd_new(const char *label, TipoDados data_type, int num_linha, char *temp, ListaILOC *codigo);
+asd_tree_t *asd_new(const char *label, TipoDados data_type, int num_linha, int temp, ListaILOC *codigo);
 
 /*
  * Função asd_tree, libera recursivamente o nó e seus filhos.
@@ -1,372 +1,598 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include "assembly.h"
-#include "iloc.h"
-#include "semantica.h"
-
-/* Mapeamento para Registradores */
-#define QTD_REG_FISICOS 4
-
-/* Lista de registradores "Callee-Saved" (Seguros entre chamadas) */
-const char *reg_fisicos[QTD_REG_FISICOS] = {
-    "%ebx", "%r12d", "%r13d", "%r14d"
-};
-
-/* Variável global para rastrear o maior registro temporário usado (para alocar stack) */
-int max_reg_idx = 0;
-
-/* Variáveis de Estado para Peephole */
-int cache_offset = -9999;
-char *cache_base = NULL;
-int cache_valido = 0; // 0 = inválido, 1 = válido
-
-/* ================================================================= */
-/* ==================== FUNÇÕES AUXILIARES ========================= */
-/* ================================================================= */
-
-void invalidar_cache() {
-    cache_valido = 0;
-    cache_offset = -9999;
-    cache_base = NULL;
-}
-
-/* Imprimir o local de uma variável (Reg ou Pilha) */
-void imprimir_local_var(int offset) {
-
-    int indice = offset / 4;
-
-    /* Tenta alocar registrador. Se acabar, usa pilha. */
-    if (indice < QTD_REG_FISICOS) {
-        printf("%s", reg_fisicos[indice]);
-    } else {
-        /* Se acabou os registradores, usa a pilha (Spill) */
-        printf("-%d(%%rbp)", offset + 4);
-    }
-}
-
-/* Extrai o ID numérico de um registrador. Ex: "r5" -> 5 */
-int obter_id_reg(char *reg) {
-    if (!reg || reg[0] != 'r') return -1;
-    /* Registradores especiais */
-    if (strcmp(reg, "rfp") == 0) return -2;
-    if (strcmp(reg, "rbss") == 0) return -3;
-    if (strcmp(reg, "rsp") == 0) return -4;
-    return atoi(reg + 1); /* Pula o 'r' */
-}
-
-/* Calcula quanto espaço de pilha é necessário varrendo todo o código */
-void calc_tamanho_pilha(ListaILOC *lista) {
-    if (!lista) return;
-    OperacaoILOC *op = lista->primeira;
-    while(op) {
-        /* Verifica fontes */
-        for(int i=0; i<op->num_fonte; i++) {
-            if(op->operandos_fonte[i].tipo == OPERAND_REGISTER) {
-                int id = obter_id_reg(op->operandos_fonte[i].valor.reg);
-                if(id > max_reg_idx) max_reg_idx = id;
-            }
-        }
-        /* Verifica alvos */
-        for(int i=0; i<op->num_alvo; i++) {
-            if(op->operandos_alvo[i].tipo == OPERAND_REGISTER) {
-                int id = obter_id_reg(op->operandos_alvo[i].valor.reg);
-                if(id > max_reg_idx) max_reg_idx = id;
-            }
-        }
-        op = op->proximo;
-    }
-}
-
-/* Imprime um operando traduzido para x86 */
-void imprimir_operando(OperandoILOC op) {
-    if (op.tipo == OPERAND_IMMEDIATE) {
-        printf("$%d", op.valor.imediato);
-    } 
-    else if (op.tipo == OPERAND_LABEL) {
-        printf(".%s", op.valor.rotulo);
-    } 
-    else if (op.tipo == OPERAND_REGISTER) {
-        int id = obter_id_reg(op.valor.reg);
-        if (id == -2) { /* rfp */
-            printf("%%rbp");
-        } else if (id == -3) { /* rbss - tratado no contexto da instrução */
-            printf("%%rip"); 
-        } else {
-            /* r0 (temp) vira offset 0, r1 vira offset 4... */
-            /* obter_id_reg retorna 0, 1, 2... Multiplicamos por 4. */
-            imprimir_local_var(id * 4);
-        }
-    }
-}
-
-/* ================================================================= */
-/* ==================== TRADUTOR DE INSTRUÇÕES ===================== */
-/* ================================================================= */
-
-void traduzir_instrucao(OperacaoILOC *op) {
-
-    /* Imprime Rótulos (Labels) */
-    if (op->rotulo) {
-
-        /* Se encontrar um rótulo, o fluxo de execução é incerto.
-           Não podemos garantir o valor de %eax vindo da instrução anterior. */
-        invalidar_cache();
-
-        /* Se for label de função, precisa ser global */
-        if (strcmp(op->rotulo, "main") == 0) {
-            printf("\t.globl\tmain\n");
-            printf("\t.type\tmain, @function\n");
-            printf("%s:\n", op->rotulo);
-        } else{
-            printf(".%s:\n", op->rotulo);
-        }
-        
-        /* Prólogo da função (se o rótulo não for um L genérico gerado pelo cbr/jump) */
-        /* Simplificação: assumindo que labels de função são nomes, e labels de fluxo são L*/
-        if (op->rotulo[0] != 'L' || strcmp(op->rotulo, "main") == 0) {
-            printf("\tpushq\t%%rbp\n");
-            printf("\tmovq\t%%rsp, %%rbp\n");
-
-            /* Salvar registradores Callee-Saved */
-            printf("\tpushq\t%%rbx\n");
-            printf("\tpushq\t%%r12\n");
-            printf("\tpushq\t%%r13\n");
-            printf("\tpushq\t%%r14\n");
-
-            /* Aloca espaço na pilha (alinhado a 16 bytes) */
-            int size = (max_reg_idx + 1) * 4;
-            if (size % 16 != 0) size += (16 - (size % 16));
-            if (size > 0) printf("\tsubq\t$%d, %%rsp\n", size);
-        }
-    }
-
-    /* Flag para saber se a instrução atual mantem o cache válido */
-    int preserva_cache = 0;
-
-    switch (op->opcode) {
-
-        /* Movimentação de Dados */
-        case OP_LOADI:
-            /* loadI C => rX  --> movl $C, MEM */
-            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", ");
-            imprimir_operando(op->operandos_alvo[0]); printf("\n");
-            break;
-
-        case OP_I2I:
-            /* i2i rA => rB --> movl rA, %eax; movl %eax, rB */
-            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
-            printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
-            break;
-        
-        case OP_LOADAI:
-            {
-                /* loadAI base, offset => dst */
-                char *base = op->operandos_fonte[0].valor.reg;
-                int offset = op->operandos_fonte[1].valor.imediato;
-                char *nome_global = op->operandos_fonte[1].nome_aux;
-
-                /* Otimização Peephole */
-                int pular_load = 0;
-                if (cache_valido && cache_base && 
-                    strcmp(base, cache_base) == 0 && offset == cache_offset) {
-                    pular_load = 1;
-                }
-
-                if (!pular_load) {
-                    if (strcmp(base, "rbss") == 0) {
-                        /* Zero lookup: Usa o nome direto da struct */
-                        if (nome_global) {
-                            printf("\tmovl\t%s(%%rip), %%eax\n", nome_global);
-                        } else {
-                            /* Fallback: usa offset numérico se necessário */
-                            printf("\tmovl\tdados_globais+%d(%%rip), %%eax\n", offset);
-                        }
-                    } else {
-                        printf("\tmovl\t");
-                        imprimir_local_var(offset);
-                        printf(", %%eax\n");
-                    }
-                }
-
-                printf("\tmovl\t%%eax, ");
-                imprimir_operando(op->operandos_alvo[0]);
-                printf("\n");
-
-                /* Atualiza o cache (após um Load, %eax == memória) */
-                cache_base = base;
-                cache_offset = offset;
-                cache_valido = 1;
-                preserva_cache = 1;
-            }
-            break;
-
-        case OP_STOREAI: 
-            {
-                char *base = op->operandos_alvo[0].valor.reg;
-                int offset = op->operandos_alvo[1].valor.imediato;
-                char *nome_global = op->operandos_alvo[1].nome_aux;
-
-                printf("\tmovl\t");
-                imprimir_operando(op->operandos_fonte[0]);
-                printf(", %%eax\n");
-                
-                if (strcmp(base, "rbss") == 0) {
-                    /* Zero lookup: Usa o nome direto da struct */
-                    if (nome_global) {
-                        printf("\tmovl\t%%eax, %s(%%rip)\n", nome_global);
-                    } else {
-                        /* Fallback: usa offset numérico se necessário */
-                        printf("\tmovl\t%%eax, dados_globais+%d(%%rip)\n", offset);
-                    }
-                } else {
-                    printf("\tmovl\t%%eax, ");
-                    imprimir_local_var(offset);
-                    printf("\n");
-                }
-
-                /* Atualiza o cache (após um Store, %eax == memória) */
-                cache_base = base;
-                cache_offset = offset;
-                cache_valido = 1;
-                preserva_cache = 1;
-            }
-            break;
-
-
-        /* Aritmética e Lógica */
-        case OP_ADD:
-        case OP_SUB:
-        case OP_MULT:
-        case OP_AND:
-        case OP_OR:
-        case OP_XOR:
-            {
-                const char *mnemonico;
-                switch(op->opcode) {
-                    case OP_ADD: mnemonico = "addl"; break;
-                    case OP_SUB: mnemonico = "subl"; break;
-                    case OP_MULT: mnemonico = "imull"; break;
-                    case OP_AND: mnemonico = "andl"; break;
-                    case OP_OR:  mnemonico = "orl"; break;
-                    case OP_XOR: mnemonico = "xorl"; break;
-                    default: mnemonico = "nop"; break;
-                }
-
-                printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
-                printf("\t%s\t", mnemonico); imprimir_operando(op->operandos_fonte[1]); printf(", %%eax\n");
-                printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
-            }
-            break;
-        
-        case OP_DIV:
-            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
-            printf("\tcltd\n"); /* EAX -> EDX:EAX */
-            printf("\tidivl\t"); imprimir_operando(op->operandos_fonte[1]); printf("\n");
-            printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
-            break;
-
-        case OP_RSUBI: /* rsubI rA, c => rB (rB = c - rA) */
-            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[1]); printf(", %%eax\n"); /* Carrega Imediato */
-            printf("\tsubl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n"); /* Subtrai Reg */
-            printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
-            break;
-
-
-        /* Comparações */
-        case OP_CMP_LT:
-        case OP_CMP_LE:
-        case OP_CMP_EQ:
-        case OP_CMP_GE:
-        case OP_CMP_GT:
-        case OP_CMP_NE:
-            {
-                char *set_cc;
-                switch(op->opcode) {
-                    case OP_CMP_LT: set_cc = "setl"; break;
-                    case OP_CMP_LE: set_cc = "setle"; break;
-                    case OP_CMP_EQ: set_cc = "sete"; break;
-                    case OP_CMP_GE: set_cc = "setge"; break;
-                    case OP_CMP_GT: set_cc = "setg"; break;
-                    case OP_CMP_NE: set_cc = "setne"; break;
-                    default: set_cc = "sete"; break;
-                }
-
-                printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
-                printf("\tcmpl\t"); imprimir_operando(op->operandos_fonte[1]); printf(", %%eax\n");
-                printf("\t%s\t%%al\n", set_cc);
-                printf("\tmovzbl\t%%al, %%eax\n");
-                printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
-            }
-            break;
-
-
-        /* Fluxo de Controle */
-        case OP_JUMPI:
-            printf("\tjmp\t.%s\n", op->operandos_alvo[0].valor.rotulo);
-            break;
-
-        case OP_CBR: /* cbr rCond -> Ltrue, Lfalse */
-            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
-            printf("\tcmpl\t$0, %%eax\n");
-            printf("\tjne\t.%s\n", op->operandos_alvo[0].valor.rotulo);
-            printf("\tjmp\t.%s\n", op->operandos_alvo[1].valor.rotulo);
-            break;
-
-
-        /* Funções */
-        case OP_RET:
-            if (op->num_fonte > 0) {
-                printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
-            }
-
-            /* Restaurar registradores (Ordem Inversa do Push) */
-            printf("\tpopq\t%%r14\n");
-            printf("\tpopq\t%%r13\n");
-            printf("\tpopq\t%%r12\n");
-            printf("\tpopq\t%%rbx\n");
-
-            printf("\tleave\n");
-            printf("\tret\n");
-            break;
-
-        default:
-            /* Opcode não implementado ou ignorado */
-            break;
-
-    }
-
-    /* Se a instrução altera %eax e não é um dos casos acima, invalida */
-    if (!preserva_cache) {
-        invalidar_cache();
-    }
-}
-
-/* ================================================================= */
-/* ======================== FUNÇÃO PRINCIPAL ======================= */
-/* ================================================================= */
-
-void gerar_assembly(asd_tree_t *arvore) {
-    if (!arvore || !arvore->codigo) return;
-
-    /* Cabeçalho Assembly */
-    printf("\t.file\t\"programa.c\"\n");
-
-    /* Gera as variáveis globais a partir da tabela de símbolos */
-    printf("\t.data\n");
-    gerar_segmento_dados();
-    printf("\t.text\n");
-
-    /* Calcula tamanho da pilha baseado no maior registrador usado em todo o programa */
-    calc_tamanho_pilha(arvore->codigo);
-
-    /* Itera sobre as instruções */
-    OperacaoILOC *op = arvore->codigo->primeira;
-    while(op) {
-        traduzir_instrucao(op);
-        op = op->proximo;
-    }
-
-    printf("\t.ident\t\"Compilador E6\"\n");
-    printf("\t.section\t.note.GNU-stack,\"\",@progbits\n");
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "assembly.h"
+#include "iloc.h"
+#include "alocacao.h"
+#include "selecao.h"
+#include "passes.h"
+#include "semantica.h"
+
+/* Alocação de registradores da função sendo traduzida */
+Alocacao *aloc_atual = NULL;
+
+/* Função sendo traduzida e posição da última instrução consumida */
+FuncaoILOC *funcao_atual = NULL;
+int posicao_atual = 0;
+
+/* Padrões escolhidos para as operações aritméticas da função */
+Selecao *selecao_atual = NULL;
+
+/* Estratégia de alocação escolhida na linha de comando */
+ModoAlocacao modo_alocacao = ALOC_LINEAR;
+
+/* Frame endereçado por %rsp, sem %rbp (que vira alocável) */
+int omitir_frame_pointer = 0;
+
+/* Variáveis de Estado para Peephole */
+int cache_offset = -9999;
+int cache_base = REG_NENHUM;
+int cache_valido = 0; // 0 = inválido, 1 = válido
+
+/* ================================================================= */
+/* ==================== FUNÇÕES AUXILIARES ========================= */
+/* ================================================================= */
+
+void invalidar_cache() {
+    cache_valido = 0;
+    cache_offset = -9999;
+    cache_base = REG_NENHUM;
+}
+
+/* Imprime o local de um registrador virtual (Reg, Pilha ou Imediato) */
+void imprimir_vreg(int vreg) {
+    if (aloc_atual->rematerializavel[vreg]) {
+        /* Constante rematerializada: vai direto como imediato */
+        printf("$%d", aloc_atual->valor_constante[vreg]);
+    } else if (aloc_atual->reg[vreg] >= 0) {
+        printf("%s", reg_fisicos[aloc_atual->reg[vreg]]);
+    } else if (omitir_frame_pointer) {
+        /* Spill sem frame pointer: slots começam no topo da pilha */
+        printf("%d(%%rsp)", deslocamento_spill(aloc_atual, vreg) - 4);
+    } else {
+        /* Não coube nos registradores, usa a pilha (Spill) */
+        printf("-%d(%%rbp)", deslocamento_spill(aloc_atual, vreg));
+    }
+}
+
+/* Indica se o vreg ficou em um registrador físico */
+int em_registrador(int vreg) {
+    return aloc_atual->reg[vreg] >= 0;
+}
+
+/* Indica se o vreg é uma constante rematerializada (imediato) */
+int eh_constante(int vreg) {
+    return aloc_atual->rematerializavel[vreg];
+}
+
+/* Indica se dois vregs ocupam o mesmo lugar (mesmo registrador ou mesmo slot) */
+int mesmo_local(int v1, int v2) {
+    if (eh_constante(v1) || eh_constante(v2)) return 0;
+    if (em_registrador(v1) || em_registrador(v2)) {
+        return aloc_atual->reg[v1] == aloc_atual->reg[v2];
+    }
+    return deslocamento_spill(aloc_atual, v1) == deslocamento_spill(aloc_atual, v2);
+}
+
+/* Indica se, ao cair da instrução atual, a execução chega ao rótulo sem
+   passar por código (nops rotulados não geram instruções) */
+int cai_no_rotulo(int rotulo) {
+    for (int j = posicao_atual + 1; j < funcao_atual->num_ops; j++) {
+        OperacaoILOC *op = &funcao_atual->ops[j];
+        if (op->rotulo == rotulo) return 1;
+        if (op->opcode != OP_NOP) return 0;
+    }
+    return 0;
+}
+
+/* Emite o par de saltos de um desvio condicional. Quando um dos alvos é a
+   próxima instrução, só sobra um salto (com a condição invertida se for o
+   alvo verdadeiro que cai). */
+void emitir_desvio(const char *jcc, const char *jcc_inverso, int verdadeiro, int falso) {
+    if (cai_no_rotulo(verdadeiro)) {
+        printf("\t%s\t.L%d\n", jcc_inverso, falso);
+    } else if (cai_no_rotulo(falso)) {
+        printf("\t%s\t.L%d\n", jcc, verdadeiro);
+    } else {
+        printf("\t%s\t.L%d\n", jcc, verdadeiro);
+        printf("\tjmp\t.L%d\n", falso);
+    }
+}
+
+/* Imprime o endereço de uma global: pelo nome do símbolo, ou pelo offset
+   na área de dados quando não há símbolo */
+void imprimir_global(const char *nome_global, int offset) {
+    if (nome_global) printf("%s(%%rip)", nome_global);
+    else printf("dados_globais+%d(%%rip)", offset);
+}
+
+/* Imprimir o local de uma variável (Reg ou Pilha) */
+void imprimir_local_var(int offset) {
+    imprimir_vreg(vreg_local(aloc_atual, offset));
+}
+
+/* Imprime um operando traduzido para x86 */
+void imprimir_operando(OperandoILOC op) {
+    if (op.tipo == OPERAND_IMMEDIATE) {
+        printf("$%d", op.valor.imediato);
+    } 
+    else if (op.tipo == OPERAND_LABEL) {
+        printf(".L%d", op.valor.rotulo);
+    } 
+    else if (op.tipo == OPERAND_REGISTER) {
+        int id = op.valor.reg;
+        if (id == REG_RFP) {
+            printf(omitir_frame_pointer ? "%%rsp" : "%%rbp");
+        } else if (id == REG_RBSS) { /* tratado no contexto da instrução */
+            printf("%%rip"); 
+        } else {
+            imprimir_vreg(vreg_registrador(aloc_atual, op.valor.reg));
+        }
+    }
+}
+
+/* ================================================================= */
+/* ===================== PRÓLOGO E EPÍLOGO ========================= */
+/* ================================================================= */
+
+/* Só os callee-saved que o corpo da função realmente escreve */
+int precisa_salvar(int r) {
+    return reg_callee_saved[r] && aloc_atual->escritos[r];
+}
+
+/* Bytes reservados para os slots de spill. O total empilhado pela função
+   (endereço de retorno, %rbp se houver, callee-saved e slots) mantém %rsp
+   alinhado a 16. */
+int tamanho_frame() {
+    int empilhados = omitir_frame_pointer ? 8 : 16;
+    for (int r = 0; r < QTD_REG_FISICOS; r++) {
+        if (precisa_salvar(r)) empilhados += 8;
+    }
+    int size = aloc_atual->num_slots * 4;
+    int resto = (empilhados + size) % 16;
+    if (resto != 0) size += 16 - resto;
+    return size;
+}
+
+void emitir_prologo() {
+    int size = tamanho_frame();
+
+    if (omitir_frame_pointer) {
+        /* Sem %rbp: salva os callee-saved e abre os slots abaixo deles,
+           endereçados a partir de %rsp com deslocamentos fixos */
+        for (int r = 0; r < QTD_REG_FISICOS; r++) {
+            if (precisa_salvar(r)) printf("\tpushq\t%s\n", reg_fisicos_64[r]);
+        }
+        if (size > 0) printf("\tsubq\t$%d, %%rsp\n", size);
+        return;
+    }
+
+    printf("\tpushq\t%%rbp\n");
+    printf("\tmovq\t%%rsp, %%rbp\n");
+
+    /* Frame exato da função: os slots de spill ficam logo abaixo de %rbp e os
+       registradores salvos abaixo deles */
+    if (size > 0) printf("\tsubq\t$%d, %%rsp\n", size);
+
+    /* Salvar registradores Callee-Saved que a função escreve */
+    for (int r = 0; r < QTD_REG_FISICOS; r++) {
+        if (precisa_salvar(r)) printf("\tpushq\t%s\n", reg_fisicos_64[r]);
+    }
+}
+
+void emitir_epilogo() {
+    if (omitir_frame_pointer) {
+        int size = tamanho_frame();
+        if (size > 0) printf("\taddq\t$%d, %%rsp\n", size);
+    }
+
+    /* Restaurar registradores (Ordem Inversa do Push) */
+    for (int r = QTD_REG_FISICOS - 1; r >= 0; r--) {
+        if (precisa_salvar(r)) printf("\tpopq\t%s\n", reg_fisicos_64[r]);
+    }
+
+    if (!omitir_frame_pointer) printf("\tleave\n");
+    printf("\tret\n");
+}
+
+/* ================================================================= */
+/* ==================== TRADUTOR DE INSTRUÇÕES ===================== */
+/* ================================================================= */
+
+/* Imprime o rótulo da instrução, se houver (e o prólogo, se for de função) */
+void traduzir_rotulo(OperacaoILOC *op) {
+    if (tem_rotulo(op)) {
+
+        /* Se encontrar um rótulo, o fluxo de execução é incerto.
+           Não podemos garantir o valor de %eax vindo da instrução anterior. */
+        invalidar_cache();
+
+        /* Se for label de função, precisa ser global */
+        if (!op->funcao) {
+            printf(".L%d:\n", op->rotulo);
+        } else if (strcmp(nome_simbolo(op->funcao), "main") == 0) {
+            printf("\t.globl\tmain\n");
+            printf("\t.type\tmain, @function\n");
+            printf("main:\n");
+        } else{
+            printf(".%s:\n", nome_simbolo(op->funcao));
+        }
+        
+        /* Prólogo da função (se o rótulo não for um L genérico gerado pelo cbr/jump) */
+        /* Simplificação: assumindo que labels de função são nomes, e labels de fluxo são L*/
+        if (eh_inicio_funcao(op)) {
+            emitir_prologo();
+        }
+    }
+}
+
+void traduzir_instrucao(OperacaoILOC *op) {
+
+    /* Imprime Rótulos (Labels) */
+    traduzir_rotulo(op);
+
+    /* Flag para saber se a instrução atual mantem o cache válido */
+    int preserva_cache = 0;
+
+    switch (op->opcode) {
+
+        /* Movimentação de Dados */
+        case OP_LOADI:
+            /* Constante rematerializada: aparece como imediato nos usos */
+            if (eh_constante(vreg_registrador(aloc_atual, op->operandos_alvo[0].valor.reg))) break;
+
+            /* loadI C => rX  --> movl $C, MEM */
+            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", ");
+            imprimir_operando(op->operandos_alvo[0]); printf("\n");
+            break;
+
+        case OP_I2I:
+            {
+                int origem = vreg_registrador(aloc_atual, op->operandos_fonte[0].valor.reg);
+                int destino = vreg_registrador(aloc_atual, op->operandos_alvo[0].valor.reg);
+
+                /* Coalescidos no mesmo lugar: a cópia desaparece */
+                if (mesmo_local(origem, destino)) break;
+
+                if (em_registrador(origem) || eh_constante(origem) || em_registrador(destino)) {
+                    /* i2i rA => rB --> movl rA, rB */
+                    printf("\tmovl\t"); imprimir_vreg(origem); printf(", "); imprimir_vreg(destino); printf("\n");
+                } else {
+                    /* i2i rA => rB --> movl rA, %eax; movl %eax, rB */
+                    printf("\tmovl\t"); imprimir_vreg(origem); printf(", %%eax\n");
+                    printf("\tmovl\t%%eax, "); imprimir_vreg(destino); printf("\n");
+                }
+            }
+            break;
+        
+        case OP_LOADAI:
+            {
+                /* loadAI base, offset => dst */
+                int base = op->operandos_fonte[0].valor.reg;
+                int offset = op->operandos_fonte[1].valor.imediato;
+                const char *nome_global = nome_simbolo(op->operandos_fonte[1].simbolo);
+
+                /* Otimização Peephole */
+                int pular_load = 0;
+                if (cache_valido && base == cache_base && offset == cache_offset) {
+                    pular_load = 1;
+                }
+
+                /* Local em registrador: é uma cópia entre vregs */
+                if (!pular_load && base == REG_RFP) {
+                    int origem = vreg_local(aloc_atual, offset);
+                    int destino = vreg_registrador(aloc_atual, op->operandos_alvo[0].valor.reg);
+                    if (mesmo_local(origem, destino)) break;
+                    if (em_registrador(origem) || em_registrador(destino)) {
+                        printf("\tmovl\t"); imprimir_vreg(origem); printf(", "); imprimir_vreg(destino); printf("\n");
+                        break;
+                    }
+                }
+
+                /* Global com destino em registrador: carrega direto nele */
+                if (!pular_load && base == REG_RBSS &&
+                    em_registrador(vreg_registrador(aloc_atual, op->operandos_alvo[0].valor.reg))) {
+                    printf("\tmovl\t"); imprimir_global(nome_global, offset); printf(", ");
+                    imprimir_operando(op->operandos_alvo[0]); printf("\n");
+                    break;
+                }
+
+                if (!pular_load) {
+                    if (base == REG_RBSS) {
+                        printf("\tmovl\t"); imprimir_global(nome_global, offset); printf(", %%eax\n");
+                    } else {
+                        printf("\tmovl\t");
+                        imprimir_local_var(offset);
+                        printf(", %%eax\n");
+                    }
+                }
+
+                printf("\tmovl\t%%eax, ");
+                imprimir_operando(op->operandos_alvo[0]);
+                printf("\n");
+
+                /* Atualiza o cache (após um Load, %eax == memória) */
+                cache_base = base;
+                cache_offset = offset;
+                cache_valido = 1;
+                preserva_cache = 1;
+            }
+            break;
+
+        case OP_STOREAI: 
+            {
+                int base = op->operandos_alvo[0].valor.reg;
+                int offset = op->operandos_alvo[1].valor.imediato;
+                const char *nome_global = nome_simbolo(op->operandos_alvo[1].simbolo);
+
+                /* Local em registrador: é uma cópia entre vregs */
+                if (base == REG_RFP) {
+                    int origem = vreg_registrador(aloc_atual, op->operandos_fonte[0].valor.reg);
+                    int destino = vreg_local(aloc_atual, offset);
+                    if (mesmo_local(origem, destino)) break;
+                    if (em_registrador(origem) || eh_constante(origem) || em_registrador(destino)) {
+                        printf("\tmovl\t"); imprimir_vreg(origem); printf(", "); imprimir_vreg(destino); printf("\n");
+                        break;
+                    }
+                }
+
+                /* Global com valor em registrador ou constante: store direto */
+                if (base == REG_RBSS) {
+                    int origem = vreg_registrador(aloc_atual, op->operandos_fonte[0].valor.reg);
+                    if (origem >= 0 && (em_registrador(origem) || eh_constante(origem))) {
+                        printf("\tmovl\t"); imprimir_vreg(origem); printf(", ");
+                        imprimir_global(nome_global, offset); printf("\n");
+                        break;
+                    }
+                }
+
+                printf("\tmovl\t");
+                imprimir_operando(op->operandos_fonte[0]);
+                printf(", %%eax\n");
+                
+                if (base == REG_RBSS) {
+                    printf("\tmovl\t%%eax, "); imprimir_global(nome_global, offset); printf("\n");
+                } else {
+                    printf("\tmovl\t%%eax, ");
+                    imprimir_local_var(offset);
+                    printf("\n");
+                }
+
+                /* Atualiza o cache (após um Store, %eax == memória) */
+                cache_base = base;
+                cache_offset = offset;
+                cache_valido = 1;
+                preserva_cache = 1;
+            }
+            break;
+
+
+        /* Aritmética e Lógica: padrão escolhido pelo seletor (selecao.c) */
+        case OP_ADD:
+        case OP_SUB:
+        case OP_MULT:
+        case OP_AND:
+        case OP_OR:
+        case OP_XOR:
+        case OP_RSUBI:
+        case OP_ADDI:
+        case OP_SUBI:
+        case OP_MULTI:
+        case OP_ANDI:
+        case OP_ORI:
+        case OP_XORI:
+        case OP_LSHIFTI:
+        case OP_RSHIFTI:
+            emitir_selecionada(selecao_atual, posicao_atual);
+            break;
+        
+        case OP_DIV:
+            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
+            printf("\tcltd\n"); /* EAX -> EDX:EAX */
+            printf("\tidivl\t"); imprimir_operando(op->operandos_fonte[1]); printf("\n");
+            printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
+            break;
+
+        case OP_DIVI:
+            {
+                int divisor = op->operandos_fonte[1].valor.imediato;
+                printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
+                printf("\tcltd\n");
+                if (divisor >= 2 && (divisor & (divisor - 1)) == 0) {
+                    /* Potência de dois: soma 2^k - 1 aos negativos (arredonda para zero) e desloca */
+                    printf("\tandl\t$%d, %%edx\n", divisor - 1);
+                    printf("\taddl\t%%edx, %%eax\n");
+                    printf("\tsarl\t$%d, %%eax\n", __builtin_ctz(divisor));
+                } else {
+                    /* idivl não aceita imediato: o divisor passa pelo destino, ainda livre */
+                    printf("\tmovl\t$%d, ", divisor); imprimir_operando(op->operandos_alvo[0]); printf("\n");
+                    printf("\tidivl\t"); imprimir_operando(op->operandos_alvo[0]); printf("\n");
+                }
+                printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
+            }
+            break;
+
+        /* Comparações */
+        case OP_CMP_LT:
+        case OP_CMP_LE:
+        case OP_CMP_EQ:
+        case OP_CMP_GE:
+        case OP_CMP_GT:
+        case OP_CMP_NE:
+            {
+                char *set_cc;
+                switch(op->opcode) {
+                    case OP_CMP_LT: set_cc = "setl"; break;
+                    case OP_CMP_LE: set_cc = "setle"; break;
+                    case OP_CMP_EQ: set_cc = "sete"; break;
+                    case OP_CMP_GE: set_cc = "setge"; break;
+                    case OP_CMP_GT: set_cc = "setg"; break;
+                    case OP_CMP_NE: set_cc = "setne"; break;
+                    default: set_cc = "sete"; break;
+                }
+
+                printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
+                printf("\tcmpl\t"); imprimir_operando(op->operandos_fonte[1]); printf(", %%eax\n");
+                printf("\t%s\t%%al\n", set_cc);
+                printf("\tmovzbl\t%%al, %%eax\n");
+                printf("\tmovl\t%%eax, "); imprimir_operando(op->operandos_alvo[0]); printf("\n");
+            }
+            break;
+
+
+        /* Fluxo de Controle */
+        case OP_JUMPI:
+            /* Salto para o bloco seguinte vira fall-through */
+            if (cai_no_rotulo(op->operandos_alvo[0].valor.rotulo)) break;
+            printf("\tjmp\t.L%d\n", op->operandos_alvo[0].valor.rotulo);
+            break;
+
+        case OP_CBR: /* cbr rCond -> Ltrue, Lfalse */
+            printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
+            printf("\tcmpl\t$0, %%eax\n");
+            emitir_desvio("jne", "je", op->operandos_alvo[0].valor.rotulo, op->operandos_alvo[1].valor.rotulo);
+            break;
+
+
+        /* Funções */
+        case OP_RET:
+            if (op->num_fonte > 0) {
+                printf("\tmovl\t"); imprimir_operando(op->operandos_fonte[0]); printf(", %%eax\n");
+            }
+
+            emitir_epilogo();
+            break;
+
+        default:
+            /* Opcode não implementado ou ignorado */
+            break;
+
+    }
+
+    /* Se a instrução altera %eax e não é um dos casos acima, invalida */
+    if (!preserva_cache) {
+        invalidar_cache();
+    }
+}
+
+/* ================================================================= */
+/* ================ COMPARAÇÃO + DESVIO (FUSÃO) ==================== */
+/* ================================================================= */
+
+/* Quantos operandos fonte da função leem cada vreg */
+int* contar_usos(FuncaoILOC *funcao) {
+    int *usos = (int*)calloc(aloc_atual->num_vregs + 1, sizeof(int));
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        for (int k = 0; k < op->num_fonte; k++) {
+            if (op->operandos_fonte[k].tipo != OPERAND_REGISTER) continue;
+            int v = vreg_registrador(aloc_atual, op->operandos_fonte[k].valor.reg);
+            if (v >= 0) usos[v]++;
+        }
+    }
+    return usos;
+}
+
+/* Uma comparação pode virar cmpl + jcc quando o único leitor do seu
+   resultado é o cbr logo em seguida (que não pode ser alvo de salto) */
+int pode_fundir(OperacaoILOC *cmp, OperacaoILOC *cbr, int *usos) {
+    if (cmp->opcode < OP_CMP_LT || cmp->opcode > OP_CMP_NE) return 0;
+    if (!cbr || cbr->opcode != OP_CBR || tem_rotulo(cbr)) return 0;
+
+    int resultado = vreg_registrador(aloc_atual, cmp->operandos_alvo[0].valor.reg);
+    int condicao = vreg_registrador(aloc_atual, cbr->operandos_fonte[0].valor.reg);
+    return resultado >= 0 && resultado == condicao && usos[resultado] == 1;
+}
+
+/* cmp_XX rA, rB => rC; cbr rC -> L1, L2  -->  cmpl rB, rA; jXX L1; jmp L2
+   O booleano nunca é materializado. Chamada com posicao_atual no cbr. */
+void traduzir_comparacao_desvio(OperacaoILOC *cmp, OperacaoILOC *cbr) {
+    char *jcc, *jcc_inverso;
+    switch (cmp->opcode) {
+        case OP_CMP_LT: jcc = "jl";  jcc_inverso = "jge"; break;
+        case OP_CMP_LE: jcc = "jle"; jcc_inverso = "jg";  break;
+        case OP_CMP_EQ: jcc = "je";  jcc_inverso = "jne"; break;
+        case OP_CMP_GE: jcc = "jge"; jcc_inverso = "jl";  break;
+        case OP_CMP_GT: jcc = "jg";  jcc_inverso = "jle"; break;
+        case OP_CMP_NE: jcc = "jne"; jcc_inverso = "je";  break;
+        default: jcc = "jne"; jcc_inverso = "je"; break;
+    }
+
+    traduzir_rotulo(cmp);
+
+    /* O primeiro operando do cmpl x86 (o da direita) precisa ser registrador */
+    OperandoILOC esq = cmp->operandos_fonte[0];
+    int v = (esq.tipo == OPERAND_REGISTER) ? vreg_registrador(aloc_atual, esq.valor.reg) : -1;
+    if (v >= 0 && em_registrador(v)) {
+        printf("\tcmpl\t"); imprimir_operando(cmp->operandos_fonte[1]); printf(", ");
+        imprimir_vreg(v); printf("\n");
+    } else {
+        printf("\tmovl\t"); imprimir_operando(esq); printf(", %%eax\n");
+        printf("\tcmpl\t"); imprimir_operando(cmp->operandos_fonte[1]); printf(", %%eax\n");
+    }
+
+    emitir_desvio(jcc, jcc_inverso, cbr->operandos_alvo[0].valor.rotulo, cbr->operandos_alvo[1].valor.rotulo);
+
+    invalidar_cache();
+}
+
+/* ================================================================= */
+/* ======================== FUNÇÃO PRINCIPAL ======================= */
+/* ================================================================= */
+
+void gerar_assembly(asd_tree_t *arvore) {
+    if (!arvore || !arvore->codigo) return;
+
+    /* Cabeçalho Assembly */
+    printf("\t.file\t\"programa.c\"\n");
+
+    /* Gera as variáveis globais a partir da tabela de símbolos */
+    printf("\t.data\n");
+    gerar_segmento_dados();
+    printf("\t.text\n");
+
+    /* Cada função tem sua própria alocação de registradores */
+    int num_funcoes;
+    FuncaoILOC *funcoes = separar_funcoes(arvore->codigo, &num_funcoes);
+
+    for (int f = 0; f < num_funcoes; f++) {
+        /* Passes da sequência escolhida (-O ou -passes=). A alocação vem
+           depois: a ordem deixada pelos passes (o layout) é a dos intervalos */
+        executar_passes(&funcoes[f]);
+        funcao_atual = &funcoes[f];
+
+        aloc_atual = alocar_registradores(&funcoes[f], modo_alocacao, omitir_frame_pointer);
+
+        int *usos = contar_usos(&funcoes[f]);
+        selecao_atual = selecionar_instrucoes(&funcoes[f], aloc_atual, usos);
+
+        /* Itera sobre as instruções */
+        for (int i = 0; i < funcoes[f].num_ops; i++) {
+            OperacaoILOC *op = &funcoes[f].ops[i];
+
+            /* Absorvida pelo padrão da operação que a consome */
+            if (selecao_atual->coberto[i]) continue;
+
+            OperacaoILOC *prox = (i + 1 < funcoes[f].num_ops) ? &funcoes[f].ops[i + 1] : NULL;
+
+            if (pode_fundir(op, prox, usos)) {
+                posicao_atual = ++i;
+                traduzir_comparacao_desvio(op, prox);
+            } else {
+                posicao_atual = i;
+                traduzir_instrucao(op);
+            }
+        }
+
+        liberar_selecao(selecao_atual);
+        selecao_atual = NULL;
+        free(usos);
+        liberar_alocacao(aloc_atual);
+        aloc_atual = NULL;
+    }
+
+    liberar_funcoes(funcoes, num_funcoes);
+
+    printf("\t.ident\t\"Compilador E6\"\n");
+    printf("\t.section\t.note.GNU-stack,\"\",@progbits\n");
 }
\ No newline at end of file
@@ -1,9 +1,19 @@
-#ifndef ASSEMBLY_H
-#define ASSEMBLY_H
-
-#include "asd.h"
-
-/* Gera o código assembly x86_64 na saída padrão */
-void gerar_assembly(asd_tree_t *arvore);
-
+#ifndef ASSEMBLY_H
+#define ASSEMBLY_H
+
+#include "asd.h"
+#include "alocacao.h"
+
+/* Estratégia de alocação de registradores (ALOC_GRAFO com -O2) */
+extern ModoAlocacao modo_alocacao;
+
+/* Omite o frame pointer: frame via %rsp e %rbp alocável (-fomit-frame-pointer) */
+extern int omitir_frame_pointer;
+
+/* Imprime o local de um vreg da função em tradução (registrador, pilha ou $imediato) */
+void imprimir_vreg(int vreg);
+
+/* Gera o código assembly x86_64 na saída padrão */
+void gerar_assembly(asd_tree_t *arvore);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cfg.h"
+
+int eh_desvio(Opcode op) {
+    return op == OP_CBR || op == OP_JUMPI || op == OP_JUMP || op == OP_RET;
+}
+
+/* Acrescenta a aresta b -> s (um cbr com os dois alvos iguais gera uma só) */
+static void ligar(BlocoBasico *b, int s) {
+    if (s < 0) return;
+    for (int k = 0; k < b->num_sucessores; k++) {
+        if (b->sucessores[k] == s) return;
+    }
+    b->sucessores[b->num_sucessores++] = s;
+}
+
+/* Bloco de destino de um rótulo, ou -1 se ele não pertence à função */
+static int bloco_alvo(int rotulo, int *bloco_do_rotulo, int max_rotulo) {
+    if (rotulo < 0 || rotulo > max_rotulo) return -1;
+    return bloco_do_rotulo[rotulo];
+}
+
+/* Busca em profundidade iterativa (a pilha explícita aguenta funções com
+   dezenas de milhares de blocos) numerando a pós-ordem reversa */
+static void numerar_rpo(CFG *cfg) {
+    int n = cfg->num_blocos;
+    int *visitado = (int*)calloc(n, sizeof(int));
+    int *pilha = (int*)malloc(n * sizeof(int));
+    int *proxima_aresta = (int*)calloc(n, sizeof(int));
+    int *pos_ordem = (int*)malloc(n * sizeof(int));
+    int num_pos = 0, topo = 0;
+
+    pilha[topo++] = 0;
+    visitado[0] = 1;
+    while (topo > 0) {
+        int b = pilha[topo - 1];
+        BlocoBasico *bl = &cfg->blocos[b];
+        if (proxima_aresta[b] < bl->num_sucessores) {
+            int s = bl->sucessores[proxima_aresta[b]++];
+            if (!visitado[s]) {
+                visitado[s] = 1;
+                pilha[topo++] = s;
+            }
+        } else {
+            pos_ordem[num_pos++] = b;
+            topo--;
+        }
+    }
+
+    cfg->ordem_rpo = (int*)malloc((num_pos + 1) * sizeof(int));
+    cfg->num_rpo = num_pos;
+    for (int b = 0; b < n; b++) cfg->blocos[b].rpo = -1;
+    for (int i = 0; i < num_pos; i++) {
+        int b = pos_ordem[num_pos - 1 - i];
+        cfg->ordem_rpo[i] = b;
+        cfg->blocos[b].rpo = i;
+    }
+
+    free(pos_ordem);
+    free(proxima_aresta);
+    free(pilha);
+    free(visitado);
+}
+
+CFG* construir_cfg(FuncaoILOC *funcao) {
+    int n = funcao->num_ops;
+    CFG *cfg = (CFG*)calloc(1, sizeof(CFG));
+    cfg->blocos = (BlocoBasico*)malloc((n + 1) * sizeof(BlocoBasico));
+    cfg->bloco_da_op = (int*)malloc((n + 1) * sizeof(int));
+    if (n == 0) {
+        cfg->ordem_rpo = (int*)malloc(sizeof(int));
+        cfg->arestas_pred = (int*)malloc(sizeof(int));
+        return cfg;
+    }
+
+    // Mapa rótulo -> bloco
+    int max_rotulo = -1;
+    for (int i = 0; i < n; i++) {
+        if (funcao->ops[i].rotulo > max_rotulo) max_rotulo = funcao->ops[i].rotulo;
+    }
+    int *bloco_do_rotulo = (int*)malloc((max_rotulo + 2) * sizeof(int));
+    for (int r = 0; r <= max_rotulo; r++) bloco_do_rotulo[r] = -1;
+
+    // Líderes: a primeira operação, as rotuladas e as que seguem um desvio
+    int total = 0;
+    for (int i = 0; i < n; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        if (i == 0 || tem_rotulo(op) || eh_desvio(funcao->ops[i - 1].opcode)) {
+            if (total > 0) cfg->blocos[total - 1].fim = i - 1;
+            BlocoBasico *bl = &cfg->blocos[total++];
+            bl->inicio = i;
+            bl->num_sucessores = 0;
+            bl->num_predecessores = 0;
+        }
+        cfg->bloco_da_op[i] = total - 1;
+        if (op->rotulo >= 0) bloco_do_rotulo[op->rotulo] = total - 1;
+    }
+    cfg->blocos[total - 1].fim = n - 1;
+    cfg->num_blocos = total;
+
+    // Sucessores, a partir da última operação de cada bloco
+    int num_arestas = 0;
+    for (int b = 0; b < total; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        OperacaoILOC *ultima = &funcao->ops[bl->fim];
+        bl->cai = !eh_desvio(ultima->opcode) && b + 1 < total;
+        switch (ultima->opcode) {
+            case OP_CBR:
+                ligar(bl, bloco_alvo(ultima->operandos_alvo[0].valor.rotulo, bloco_do_rotulo, max_rotulo));
+                ligar(bl, bloco_alvo(ultima->operandos_alvo[1].valor.rotulo, bloco_do_rotulo, max_rotulo));
+                break;
+            case OP_JUMPI:
+                ligar(bl, bloco_alvo(ultima->operandos_alvo[0].valor.rotulo, bloco_do_rotulo, max_rotulo));
+                break;
+            case OP_RET:
+            case OP_JUMP:
+                break;
+            default:
+                if (bl->cai) ligar(bl, b + 1);
+                break;
+        }
+        num_arestas += bl->num_sucessores;
+    }
+
+    // Predecessores em um único vetor: conta, reserva as faixas e preenche
+    cfg->arestas_pred = (int*)malloc((num_arestas + 1) * sizeof(int));
+    for (int b = 0; b < total; b++) {
+        for (int k = 0; k < cfg->blocos[b].num_sucessores; k++) {
+            cfg->blocos[cfg->blocos[b].sucessores[k]].num_predecessores++;
+        }
+    }
+    int pos = 0;
+    for (int b = 0; b < total; b++) {
+        cfg->blocos[b].predecessores = cfg->arestas_pred + pos;
+        pos += cfg->blocos[b].num_predecessores;
+        cfg->blocos[b].num_predecessores = 0;
+    }
+    for (int b = 0; b < total; b++) {
+        for (int k = 0; k < cfg->blocos[b].num_sucessores; k++) {
+            BlocoBasico *s = &cfg->blocos[cfg->blocos[b].sucessores[k]];
+            s->predecessores[s->num_predecessores++] = b;
+        }
+    }
+
+    numerar_rpo(cfg);
+
+    free(bloco_do_rotulo);
+    return cfg;
+}
+
+void liberar_cfg(CFG *cfg) {
+    if (!cfg) return;
+    free(cfg->blocos);
+    free(cfg->bloco_da_op);
+    free(cfg->ordem_rpo);
+    free(cfg->arestas_pred);
+    free(cfg);
+}
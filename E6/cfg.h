@@ -0,0 +1,46 @@
+#ifndef _CFG_H_
+#define _CFG_H_
+
+#include "iloc.h"
+
+/* ============================================== */
+/* ======= GRAFO DE FLUXO DE CONTROLE (CFG) ===== */
+/* ============================================== */
+
+/* Bloco básico: operações [inicio, fim] do vetor da função */
+typedef struct bloco_basico {
+    int inicio;
+    int fim;
+    int sucessores[2];      // No máximo dois (os alvos de um cbr)
+    int num_sucessores;
+    int *predecessores;     // Aponta para dentro de CFG.arestas_pred
+    int num_predecessores;
+    int cai;                // 1 se o bloco segue, sem desvio, para o bloco seguinte
+    int rpo;                // Posição na pós-ordem reversa, ou -1 se inalcançável
+} BlocoBasico;
+
+typedef struct cfg {
+    int num_blocos;
+    BlocoBasico *blocos;    // Na ordem em que aparecem no vetor de operações
+    int *bloco_da_op;       // Por operação: bloco que a contém
+    int *ordem_rpo;         // Blocos alcançáveis a partir da entrada, em pós-ordem reversa
+    int num_rpo;
+    int *arestas_pred;      // Predecessores de todos os blocos, contíguos por bloco
+} CFG;
+
+/* ============================================== */
+/* ============== FUNÇÕES DO CFG ================ */
+/* ============================================== */
+
+/* Indica se a operação encerra um bloco básico (cbr, jumpI, jump, retorna) */
+int eh_desvio(Opcode op);
+
+/* Divide a função em blocos básicos (líderes: rótulos e operações após
+   desvios), liga sucessores e predecessores e numera os blocos em pós-ordem
+   reversa a partir do bloco 0. Tempo linear no tamanho da função. */
+CFG* construir_cfg(FuncaoILOC *funcao);
+
+/* Libera o CFG */
+void liberar_cfg(CFG *cfg);
+
+#endif // _CFG_H_
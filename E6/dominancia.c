@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dominancia.h"
+
+/* ================================================================= */
+/* ====================== DOMINADORES ============================== */
+/* ================================================================= */
+
+/* Sobe pelos dominadores dos dois blocos até se encontrarem (comparando
+   as posições na pós-ordem reversa) */
+static int intersectar(CFG *cfg, int *idom, int a, int b) {
+    while (a != b) {
+        while (cfg->blocos[a].rpo > cfg->blocos[b].rpo) a = idom[a];
+        while (cfg->blocos[b].rpo > cfg->blocos[a].rpo) b = idom[b];
+    }
+    return a;
+}
+
+/* Numera a árvore de dominadores em pré e pós-ordem (pilha explícita) */
+static void numerar_arvore(Dominancia *dom) {
+    int n = dom->num_blocos;
+    int *pilha = (int*)malloc((n + 1) * sizeof(int));
+    int *proximo_filho = (int*)malloc((n + 1) * sizeof(int));
+    int contador_pre = 0, contador_pos = 0, topo = 0;
+
+    for (int b = 0; b < n; b++) {
+        dom->pre[b] = dom->pos[b] = -1;
+        proximo_filho[b] = dom->inicio_filhos[b];
+    }
+
+    if (n > 0 && dom->idom[0] == 0) {
+        pilha[topo++] = 0;
+        dom->pre[0] = contador_pre++;
+    }
+    while (topo > 0) {
+        int b = pilha[topo - 1];
+        if (proximo_filho[b] < dom->inicio_filhos[b + 1]) {
+            int c = dom->filhos[proximo_filho[b]++];
+            dom->pre[c] = contador_pre++;
+            pilha[topo++] = c;
+        } else {
+            dom->pos[b] = contador_pos++;
+            topo--;
+        }
+    }
+
+    free(proximo_filho);
+    free(pilha);
+}
+
+Dominancia* calcular_dominancia(CFG *cfg) {
+    int n = cfg->num_blocos;
+    Dominancia *dom = (Dominancia*)malloc(sizeof(Dominancia));
+    dom->num_blocos = n;
+    dom->idom = (int*)malloc((n + 1) * sizeof(int));
+    dom->filhos = (int*)malloc((n + 1) * sizeof(int));
+    dom->inicio_filhos = (int*)calloc(n + 2, sizeof(int));
+    dom->pre = (int*)malloc((n + 1) * sizeof(int));
+    dom->pos = (int*)malloc((n + 1) * sizeof(int));
+
+    for (int b = 0; b < n; b++) dom->idom[b] = -1;
+    if (n > 0) dom->idom[0] = 0;
+
+    // Iteração até o ponto fixo na pós-ordem reversa (a entrada é ordem_rpo[0])
+    int mudou = 1;
+    while (mudou) {
+        mudou = 0;
+        for (int i = 1; i < cfg->num_rpo; i++) {
+            int b = cfg->ordem_rpo[i];
+            BlocoBasico *bl = &cfg->blocos[b];
+            int novo = -1;
+            for (int k = 0; k < bl->num_predecessores; k++) {
+                int p = bl->predecessores[k];
+                if (dom->idom[p] < 0) continue;
+                novo = (novo < 0) ? p : intersectar(cfg, dom->idom, p, novo);
+            }
+            if (novo != dom->idom[b]) {
+                dom->idom[b] = novo;
+                mudou = 1;
+            }
+        }
+    }
+
+    // Filhos de cada bloco na árvore (a entrada não é filha de si mesma)
+    for (int b = 1; b < n; b++) {
+        if (dom->idom[b] >= 0) dom->inicio_filhos[dom->idom[b] + 1]++;
+    }
+    for (int b = 0; b < n; b++) dom->inicio_filhos[b + 1] += dom->inicio_filhos[b];
+    int *preenchidos = (int*)calloc(n + 1, sizeof(int));
+    for (int b = 1; b < n; b++) {
+        int pai = dom->idom[b];
+        if (pai < 0) continue;
+        dom->filhos[dom->inicio_filhos[pai] + preenchidos[pai]++] = b;
+    }
+    free(preenchidos);
+
+    numerar_arvore(dom);
+    return dom;
+}
+
+int domina(Dominancia *dom, int a, int b) {
+    if (dom->pre[a] < 0 || dom->pre[b] < 0) return 0;
+    return dom->pre[a] <= dom->pre[b] && dom->pos[b] <= dom->pos[a];
+}
+
+void liberar_dominancia(Dominancia *dom) {
+    if (!dom) return;
+    free(dom->idom);
+    free(dom->filhos);
+    free(dom->inicio_filhos);
+    free(dom->pre);
+    free(dom->pos);
+    free(dom);
+}
+
+/* ================================================================= */
+/* ========================= LAÇOS ================================= */
+/* ================================================================= */
+
+/* Laço mais externo já encontrado que contém o laço l (com compressão de caminho) */
+static int laco_raiz(int *raiz, int l) {
+    int r = l;
+    while (raiz[r] != r) r = raiz[r];
+    while (raiz[l] != r) {
+        int prox = raiz[l];
+        raiz[l] = r;
+        l = prox;
+    }
+    return r;
+}
+
+FlorestaLacos* calcular_lacos(CFG *cfg, Dominancia *dom) {
+    int n = cfg->num_blocos;
+    FlorestaLacos *f = (FlorestaLacos*)malloc(sizeof(FlorestaLacos));
+    f->num_lacos = 0;
+    f->lacos = (Laco*)malloc((n + 1) * sizeof(Laco));
+    f->laco_do_bloco = (int*)malloc((n + 1) * sizeof(int));
+    f->profundidade = (int*)calloc(n + 1, sizeof(int));
+    for (int b = 0; b < n; b++) f->laco_do_bloco[b] = -1;
+
+    int *raiz = (int*)malloc((n + 1) * sizeof(int));
+    // Por laço, cada aresta é empilhada no máximo duas vezes (salto de volta e subida)
+    int *pilha = (int*)malloc((4 * n + 1) * sizeof(int));
+
+    // Cabeçalhos de trás para frente na pós-ordem reversa: um laço interno
+    // é dominado pelo cabeçalho do externo, então é descoberto antes dele
+    for (int i = cfg->num_rpo - 1; i >= 0; i--) {
+        int h = cfg->ordem_rpo[i];
+        BlocoBasico *bh = &cfg->blocos[h];
+        int topo = 0;
+        for (int k = 0; k < bh->num_predecessores; k++) {
+            int p = bh->predecessores[k];
+            if (domina(dom, h, p)) pilha[topo++] = p;
+        }
+        if (topo == 0) continue;
+
+        int l = f->num_lacos++;
+        f->lacos[l].cabecalho = h;
+        f->lacos[l].pai = -1;
+        raiz[l] = l;
+        f->laco_do_bloco[h] = l;
+
+        // Sobe dos saltos de volta até o cabeçalho; laços internos já
+        // encontrados são absorvidos inteiros pelo seu cabeçalho
+        while (topo > 0) {
+            int b = pilha[--topo];
+            int entrada;
+            if (f->laco_do_bloco[b] < 0) {
+                f->laco_do_bloco[b] = l;
+                entrada = b;
+            } else {
+                int r = laco_raiz(raiz, f->laco_do_bloco[b]);
+                if (r == l) continue;
+                f->lacos[r].pai = l;
+                raiz[r] = l;
+                entrada = f->lacos[r].cabecalho;
+            }
+            BlocoBasico *be = &cfg->blocos[entrada];
+            for (int k = 0; k < be->num_predecessores; k++) {
+                int p = be->predecessores[k];
+                if (cfg->blocos[p].rpo >= 0) pilha[topo++] = p;
+            }
+        }
+    }
+
+    // O pai de um laço é sempre criado depois dele
+    for (int l = f->num_lacos - 1; l >= 0; l--) {
+        int pai = f->lacos[l].pai;
+        f->lacos[l].profundidade = (pai < 0) ? 1 : f->lacos[pai].profundidade + 1;
+    }
+    for (int b = 0; b < n; b++) {
+        if (f->laco_do_bloco[b] >= 0) f->profundidade[b] = f->lacos[f->laco_do_bloco[b]].profundidade;
+    }
+
+    free(pilha);
+    free(raiz);
+    return f;
+}
+
+void liberar_lacos(FlorestaLacos *lacos) {
+    if (!lacos) return;
+    free(lacos->lacos);
+    free(lacos->laco_do_bloco);
+    free(lacos->profundidade);
+    free(lacos);
+}
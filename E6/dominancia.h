@@ -0,0 +1,58 @@
+#ifndef _DOMINANCIA_H_
+#define _DOMINANCIA_H_
+
+#include "cfg.h"
+
+/* ============================================== */
+/* ============ ÁRVORE DE DOMINADORES =========== */
+/* ============================================== */
+
+typedef struct dominancia {
+    int num_blocos;
+    int *idom;              // Por bloco: dominador imediato (a entrada aponta para si), -1 se inalcançável
+    int *filhos;            // Filhos na árvore de dominadores, contíguos por bloco
+    int *inicio_filhos;     // Por bloco: faixa [inicio_filhos[b], inicio_filhos[b + 1]) em filhos
+    int *pre;               // Numeração da árvore em pré-ordem...
+    int *pos;               // ... e em pós-ordem: consulta de dominância em O(1)
+} Dominancia;
+
+/* ============================================== */
+/* ============ FLORESTA DE LAÇOS =============== */
+/* ============================================== */
+
+/* Laço natural: cabeçalho e todos os blocos que alcançam um salto de volta
+   para ele sem passar pelo cabeçalho */
+typedef struct laco {
+    int cabecalho;
+    int pai;                // Laço imediatamente externo, ou -1
+    int profundidade;       // 1 para laços mais externos
+} Laco;
+
+typedef struct floresta_lacos {
+    int num_lacos;
+    Laco *lacos;            // Laços internos aparecem antes dos que os contêm
+    int *laco_do_bloco;     // Por bloco: laço mais interno que o contém, ou -1
+    int *profundidade;      // Por bloco: quantos laços o contêm
+} FlorestaLacos;
+
+/* ============================================== */
+/* ========== FUNÇÕES DE DOMINÂNCIA ============= */
+/* ============================================== */
+
+/* Dominadores pelo algoritmo iterativo de Cooper, Harvey e Kennedy
+   sobre a pós-ordem reversa do CFG */
+Dominancia* calcular_dominancia(CFG *cfg);
+
+/* 1 se o bloco a domina o bloco b (todo bloco domina a si mesmo) */
+int domina(Dominancia *dom, int a, int b);
+
+/* Libera a árvore de dominadores */
+void liberar_dominancia(Dominancia *dom);
+
+/* Laços naturais (arestas de volta para um dominador) e seu aninhamento */
+FlorestaLacos* calcular_lacos(CFG *cfg, Dominancia *dom);
+
+/* Libera a floresta de laços */
+void liberar_lacos(FlorestaLacos *lacos);
+
+#endif // _DOMINANCIA_H_
@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fluxo.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FLUXO_X86 1
+#endif
+
+/* ================================================================= */
+/* ================= NÚCLEOS DE CONJUNTOS DE BITS ================== */
+/* ================================================================= */
+
+int palavras_conjunto(int num_bits) {
+    int palavras = (num_bits + 63) / 64;
+    return (palavras + 3) & ~3;
+}
+
+/* --- Versões escalares: referência e fallback fora do x86 --- */
+
+static void unir_escalar(uint64_t *dst, const uint64_t *src, int palavras) {
+    for (int w = 0; w < palavras; w++) dst[w] |= src[w];
+}
+
+static void intersectar_escalar(uint64_t *dst, const uint64_t *src, int palavras) {
+    for (int w = 0; w < palavras; w++) dst[w] &= src[w];
+}
+
+static int transferir_escalar(uint64_t *dst, const uint64_t *gen, const uint64_t *entrada,
+                              const uint64_t *kill, int palavras) {
+    uint64_t diferenca = 0;
+    for (int w = 0; w < palavras; w++) {
+        uint64_t novo = gen[w] | (entrada[w] & ~kill[w]);
+        diferenca |= novo ^ dst[w];
+        dst[w] = novo;
+    }
+    return diferenca != 0;
+}
+
+#ifdef FLUXO_X86
+
+/* --- SSE2: 2 palavras por operação (sempre presente no x86-64) --- */
+
+__attribute__((target("sse2")))
+static void unir_sse2(uint64_t *dst, const uint64_t *src, int palavras) {
+    int w = 0;
+    for (; w + 2 <= palavras; w += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(dst + w));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + w));
+        _mm_storeu_si128((__m128i*)(dst + w), _mm_or_si128(a, b));
+    }
+    unir_escalar(dst + w, src + w, palavras - w);
+}
+
+__attribute__((target("sse2")))
+static void intersectar_sse2(uint64_t *dst, const uint64_t *src, int palavras) {
+    int w = 0;
+    for (; w + 2 <= palavras; w += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(dst + w));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + w));
+        _mm_storeu_si128((__m128i*)(dst + w), _mm_and_si128(a, b));
+    }
+    intersectar_escalar(dst + w, src + w, palavras - w);
+}
+
+__attribute__((target("sse2")))
+static int transferir_sse2(uint64_t *dst, const uint64_t *gen, const uint64_t *entrada,
+                           const uint64_t *kill, int palavras) {
+    __m128i diferenca = _mm_setzero_si128();
+    int w = 0;
+    for (; w + 2 <= palavras; w += 2) {
+        __m128i g = _mm_loadu_si128((const __m128i*)(gen + w));
+        __m128i e = _mm_loadu_si128((const __m128i*)(entrada + w));
+        __m128i k = _mm_loadu_si128((const __m128i*)(kill + w));
+        __m128i velho = _mm_loadu_si128((const __m128i*)(dst + w));
+        __m128i novo = _mm_or_si128(g, _mm_andnot_si128(k, e));
+        diferenca = _mm_or_si128(diferenca, _mm_xor_si128(novo, velho));
+        _mm_storeu_si128((__m128i*)(dst + w), novo);
+    }
+    int mudou = _mm_movemask_epi8(_mm_cmpeq_epi8(diferenca, _mm_setzero_si128())) != 0xFFFF;
+    return transferir_escalar(dst + w, gen + w, entrada + w, kill + w, palavras - w) || mudou;
+}
+
+/* --- AVX2: 4 palavras por operação --- */
+
+__attribute__((target("avx2")))
+static void unir_avx2(uint64_t *dst, const uint64_t *src, int palavras) {
+    int w = 0;
+    for (; w + 4 <= palavras; w += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + w));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + w));
+        _mm256_storeu_si256((__m256i*)(dst + w), _mm256_or_si256(a, b));
+    }
+    unir_escalar(dst + w, src + w, palavras - w);
+}
+
+__attribute__((target("avx2")))
+static void intersectar_avx2(uint64_t *dst, const uint64_t *src, int palavras) {
+    int w = 0;
+    for (; w + 4 <= palavras; w += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(dst + w));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + w));
+        _mm256_storeu_si256((__m256i*)(dst + w), _mm256_and_si256(a, b));
+    }
+    intersectar_escalar(dst + w, src + w, palavras - w);
+}
+
+__attribute__((target("avx2")))
+static int transferir_avx2(uint64_t *dst, const uint64_t *gen, const uint64_t *entrada,
+                           const uint64_t *kill, int palavras) {
+    __m256i diferenca = _mm256_setzero_si256();
+    int w = 0;
+    for (; w + 4 <= palavras; w += 4) {
+        __m256i g = _mm256_loadu_si256((const __m256i*)(gen + w));
+        __m256i e = _mm256_loadu_si256((const __m256i*)(entrada + w));
+        __m256i k = _mm256_loadu_si256((const __m256i*)(kill + w));
+        __m256i velho = _mm256_loadu_si256((const __m256i*)(dst + w));
+        __m256i novo = _mm256_or_si256(g, _mm256_andnot_si256(k, e));
+        diferenca = _mm256_or_si256(diferenca, _mm256_xor_si256(novo, velho));
+        _mm256_storeu_si256((__m256i*)(dst + w), novo);
+    }
+    int mudou = !_mm256_testz_si256(diferenca, diferenca);
+    return transferir_escalar(dst + w, gen + w, entrada + w, kill + w, palavras - w) || mudou;
+}
+
+#endif // FLUXO_X86
+
+/* Implementações escolhidas na primeira chamada, conforme a CPU */
+typedef struct nucleos {
+    void (*unir)(uint64_t*, const uint64_t*, int);
+    void (*intersectar)(uint64_t*, const uint64_t*, int);
+    int (*transferir)(uint64_t*, const uint64_t*, const uint64_t*, const uint64_t*, int);
+} Nucleos;
+
+static Nucleos nucleos;
+static int nucleos_prontos = 0;
+
+static void escolher_nucleos() {
+    nucleos = (Nucleos){unir_escalar, intersectar_escalar, transferir_escalar};
+#ifdef FLUXO_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        nucleos = (Nucleos){unir_avx2, intersectar_avx2, transferir_avx2};
+    } else if (__builtin_cpu_supports("sse2")) {
+        nucleos = (Nucleos){unir_sse2, intersectar_sse2, transferir_sse2};
+    }
+#endif
+    nucleos_prontos = 1;
+}
+
+void bits_unir(uint64_t *dst, const uint64_t *src, int palavras) {
+    if (!nucleos_prontos) escolher_nucleos();
+    nucleos.unir(dst, src, palavras);
+}
+
+void bits_intersectar(uint64_t *dst, const uint64_t *src, int palavras) {
+    if (!nucleos_prontos) escolher_nucleos();
+    nucleos.intersectar(dst, src, palavras);
+}
+
+int bits_transferir(uint64_t *dst, const uint64_t *gen, const uint64_t *entrada,
+                    const uint64_t *kill, int palavras) {
+    if (!nucleos_prontos) escolher_nucleos();
+    return nucleos.transferir(dst, gen, entrada, kill, palavras);
+}
+
+/* ================================================================= */
+/* ===================== RESOLUÇÃO ITERATIVA ======================= */
+/* ================================================================= */
+
+ProblemaFluxo* criar_problema_fluxo(CFG *cfg, int num_bits, DirecaoFluxo direcao, Confluencia confluencia) {
+    ProblemaFluxo *p = (ProblemaFluxo*)malloc(sizeof(ProblemaFluxo));
+    p->cfg = cfg;
+    p->direcao = direcao;
+    p->confluencia = confluencia;
+    p->num_bits = num_bits;
+    p->palavras = palavras_conjunto(num_bits);
+    if (p->palavras == 0) p->palavras = 4;
+    p->visitas = 0;
+
+    size_t total = (size_t)(cfg->num_blocos + 1) * p->palavras;
+    p->gen = (uint64_t*)calloc(total, sizeof(uint64_t));
+    p->kill = (uint64_t*)calloc(total, sizeof(uint64_t));
+    p->in = (uint64_t*)calloc(total, sizeof(uint64_t));
+    p->out = (uint64_t*)calloc(total, sizeof(uint64_t));
+    return p;
+}
+
+/* Ordem de visita: alcançáveis na pós-ordem reversa, depois os inalcançáveis.
+   Problemas para trás percorrem essa ordem de trás para frente. */
+static int* ordem_visita(ProblemaFluxo *p) {
+    CFG *cfg = p->cfg;
+    int n = cfg->num_blocos;
+    int *ordem = (int*)malloc((n + 1) * sizeof(int));
+    int k = 0;
+    for (int i = 0; i < cfg->num_rpo; i++) ordem[k++] = cfg->ordem_rpo[i];
+    for (int b = 0; b < n; b++) {
+        if (cfg->blocos[b].rpo < 0) ordem[k++] = b;
+    }
+    if (p->direcao == FLUXO_PARA_TRAS) {
+        for (int i = 0; i < n / 2; i++) {
+            int t = ordem[i];
+            ordem[i] = ordem[n - 1 - i];
+            ordem[n - 1 - i] = t;
+        }
+    }
+    return ordem;
+}
+
+void resolver_fluxo(ProblemaFluxo *p) {
+    CFG *cfg = p->cfg;
+    int n = cfg->num_blocos;
+    int palavras = p->palavras;
+    if (n == 0) return;
+
+    // Na interseção, tudo começa cheio (o topo do reticulado) e só
+    // blocos sem vizinhos na direção do fluxo partem do conjunto vazio
+    uint64_t *saida_inicial = (p->direcao == FLUXO_PARA_FRENTE) ? p->out : p->in;
+    if (p->confluencia == CONFLUENCIA_INTERSECAO) {
+        memset(saida_inicial, 0xFF, (size_t)n * palavras * sizeof(uint64_t));
+    }
+
+    // Fila circular de blocos, com marca de quem já está nela
+    int *ordem = ordem_visita(p);
+    int *fila = (int*)malloc((n + 1) * sizeof(int));
+    char *na_fila = (char*)malloc(n + 1);
+    int inicio = 0, tamanho = n;
+    for (int i = 0; i < n; i++) {
+        fila[i] = ordem[i];
+        na_fila[ordem[i]] = 1;
+    }
+
+    while (tamanho > 0) {
+        int b = fila[inicio];
+        inicio = (inicio + 1) % n;
+        tamanho--;
+        na_fila[b] = 0;
+        p->visitas++;
+
+        BlocoBasico *bl = &cfg->blocos[b];
+        int para_frente = (p->direcao == FLUXO_PARA_FRENTE);
+        int num_vizinhos = para_frente ? bl->num_predecessores : bl->num_sucessores;
+        uint64_t *confluencia = para_frente ? CONJUNTO(p, in, b) : CONJUNTO(p, out, b);
+        uint64_t *resultado = para_frente ? CONJUNTO(p, out, b) : CONJUNTO(p, in, b);
+
+        // Junta o que chega dos vizinhos
+        memset(confluencia, 0, palavras * sizeof(uint64_t));
+        for (int k = 0; k < num_vizinhos; k++) {
+            int v = para_frente ? bl->predecessores[k] : bl->sucessores[k];
+            uint64_t *chegada = para_frente ? CONJUNTO(p, out, v) : CONJUNTO(p, in, v);
+            if (p->confluencia == CONFLUENCIA_UNIAO || k == 0) {
+                bits_unir(confluencia, chegada, palavras);
+            } else {
+                bits_intersectar(confluencia, chegada, palavras);
+            }
+        }
+
+        // Aplica a transferência; se mudou, os vizinhos do outro lado voltam à fila
+        if (!bits_transferir(resultado, CONJUNTO(p, gen, b), confluencia, CONJUNTO(p, kill, b), palavras)) {
+            continue;
+        }
+        int num_afetados = para_frente ? bl->num_sucessores : bl->num_predecessores;
+        for (int k = 0; k < num_afetados; k++) {
+            int v = para_frente ? bl->sucessores[k] : bl->predecessores[k];
+            if (na_fila[v]) continue;
+            na_fila[v] = 1;
+            fila[(inicio + tamanho) % n] = v;
+            tamanho++;
+        }
+    }
+
+    free(na_fila);
+    free(fila);
+    free(ordem);
+}
+
+void liberar_problema_fluxo(ProblemaFluxo *p) {
+    if (!p) return;
+    free(p->gen);
+    free(p->kill);
+    free(p->in);
+    free(p->out);
+    free(p);
+}
@@ -0,0 +1,75 @@
+#ifndef _FLUXO_H_
+#define _FLUXO_H_
+
+#include <stdint.h>
+#include "cfg.h"
+
+/* ============================================== */
+/* ============= CONJUNTOS DE BITS ============== */
+/* ============================================== */
+
+/* Conjuntos densos: vetores de palavras de 64 bits indexados pelo elemento */
+#define BIT_SET(c, v)   ((c)[(v) >> 6] |= (UINT64_C(1) << ((v) & 63)))
+#define BIT_CLR(c, v)   ((c)[(v) >> 6] &= ~(UINT64_C(1) << ((v) & 63)))
+#define BIT_TEST(c, v)  (((c)[(v) >> 6] >> ((v) & 63)) & 1)
+
+/* Palavras necessárias para n bits, arredondadas para o tamanho de um vetor AVX2 */
+int palavras_conjunto(int num_bits);
+
+/* Núcleos vetorizados (AVX2 ou SSE2, escolhidos em tempo de execução, com
+   versão escalar quando a máquina não é x86). Todos operam sobre 'palavras'. */
+
+/* dst |= src */
+void bits_unir(uint64_t *dst, const uint64_t *src, int palavras);
+
+/* dst &= src */
+void bits_intersectar(uint64_t *dst, const uint64_t *src, int palavras);
+
+/* dst = gen | (entrada & ~kill); devolve 1 se dst mudou */
+int bits_transferir(uint64_t *dst, const uint64_t *gen, const uint64_t *entrada,
+                    const uint64_t *kill, int palavras);
+
+/* ============================================== */
+/* ========= PROBLEMAS DE FLUXO DE DADOS ======== */
+/* ============================================== */
+
+typedef enum {
+    FLUXO_PARA_FRENTE,  // in[b] = confluência dos out dos predecessores
+    FLUXO_PARA_TRAS     // out[b] = confluência dos in dos sucessores
+} DirecaoFluxo;
+
+typedef enum {
+    CONFLUENCIA_UNIAO,      // "em algum caminho" (vivacidade, definições alcançantes)
+    CONFLUENCIA_INTERSECAO  // "em todos os caminhos" (expressões disponíveis)
+} Confluencia;
+
+/* Problema sobre o CFG com função de transferência gen ∪ (x − kill).
+   O cliente preenche gen e kill de cada bloco e chama resolver_fluxo. */
+typedef struct problema_fluxo {
+    CFG *cfg;
+    DirecaoFluxo direcao;
+    Confluencia confluencia;
+    int num_bits;           // Tamanho do universo
+    int palavras;           // Palavras de 64 bits por conjunto
+    uint64_t *gen;          // Conjuntos por bloco, contíguos: bloco b em b * palavras
+    uint64_t *kill;
+    uint64_t *in;
+    uint64_t *out;
+    int visitas;            // Blocos processados até o ponto fixo
+} ProblemaFluxo;
+
+/* Conjunto do bloco b dentro de um dos vetores do problema */
+#define CONJUNTO(p, vetor, b) ((p)->vetor + (size_t)(b) * (p)->palavras)
+
+/* Cria o problema com gen, kill, in e out vazios */
+ProblemaFluxo* criar_problema_fluxo(CFG *cfg, int num_bits, DirecaoFluxo direcao, Confluencia confluencia);
+
+/* Itera com lista de trabalho (na pós-ordem reversa para problemas para frente,
+   no sentido contrário para trás) até o ponto fixo. Blocos inalcançáveis
+   também são resolvidos, pois continuam sendo emitidos. */
+void resolver_fluxo(ProblemaFluxo *p);
+
+/* Libera o problema (o CFG pertence ao chamador) */
+void liberar_problema_fluxo(ProblemaFluxo *p);
+
+#endif // _FLUXO_H_
@@ -1,7 +1,9 @@
 #include "iloc.h"
+#include "tabelaSimbolos.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 /* Contadores globais para geração de nomes de rótulos e temporários */
 static int count_temp = 1000;
@@ -16,9 +18,18 @@ const char* nome_opcode(Opcode op) {
         case OP_MULT: return "mult";
         case OP_DIV: return "div";
         case OP_RSUBI: return "rsubi";
+        case OP_ADDI: return "addI";
+        case OP_SUBI: return "subI";
+        case OP_MULTI: return "multI";
+        case OP_DIVI: return "divI";
+        case OP_LSHIFTI: return "lshiftI";
+        case OP_RSHIFTI: return "rshiftI";
         case OP_AND: return "and";
         case OP_OR: return "or";
         case OP_XOR: return "xor";
+        case OP_ANDI: return "andI";
+        case OP_ORI: return "orI";
+        case OP_XORI: return "xorI";
         case OP_LOAD: return "load";
         case OP_LOADAI: return "loadAI";
         case OP_LOADI: return "loadI";
@@ -39,61 +50,134 @@ const char* nome_opcode(Opcode op) {
     }
 }
 
+Opcode opcode_imediato(Opcode op) {
+    switch (op) {
+        case OP_ADD: return OP_ADDI;
+        case OP_SUB: return OP_SUBI;
+        case OP_MULT: return OP_MULTI;
+        case OP_DIV: return OP_DIVI;
+        case OP_AND: return OP_ANDI;
+        case OP_OR: return OP_ORI;
+        case OP_XOR: return OP_XORI;
+        default: return OP_NOP;
+    }
+}
+
+Opcode opcode_registrador(Opcode op) {
+    switch (op) {
+        case OP_ADDI: return OP_ADD;
+        case OP_SUBI: return OP_SUB;
+        case OP_MULTI: return OP_MULT;
+        case OP_DIVI: return OP_DIV;
+        case OP_ANDI: return OP_AND;
+        case OP_ORI: return OP_OR;
+        case OP_XORI: return OP_XOR;
+        default: return op;
+    }
+}
+
+int avaliar_constante(Opcode opcode, int a, int b, int *resultado) {
+    unsigned int ua = (unsigned int)a, ub = (unsigned int)b;
+    switch (opcode_registrador(opcode)) {
+        case OP_LOADI:
+        case OP_I2I:    *resultado = a; return 1;
+        case OP_ADD:    *resultado = (int)(ua + ub); return 1;
+        case OP_SUB:    *resultado = (int)(ua - ub); return 1;
+        case OP_RSUBI:  *resultado = (int)(ub - ua); return 1;
+        case OP_MULT:   *resultado = (int)(ua * ub); return 1;
+        case OP_DIV:
+            if (b == 0 || (a == INT_MIN && b == -1)) return 0;
+            *resultado = a / b;
+            return 1;
+        case OP_AND:    *resultado = a & b; return 1;
+        case OP_OR:     *resultado = a | b; return 1;
+        case OP_XOR:    *resultado = a ^ b; return 1;
+        case OP_LSHIFTI: *resultado = (int)(ua << (b & 31)); return 1;
+        case OP_RSHIFTI: *resultado = a >> (b & 31); return 1;
+        case OP_CMP_LT: *resultado = a < b; return 1;
+        case OP_CMP_LE: *resultado = a <= b; return 1;
+        case OP_CMP_EQ: *resultado = a == b; return 1;
+        case OP_CMP_GE: *resultado = a >= b; return 1;
+        case OP_CMP_GT: *resultado = a > b; return 1;
+        case OP_CMP_NE: *resultado = a != b; return 1;
+        default:        return 0;
+    }
+}
+
 /* ============================================== */
 /* =========== FUNÇÕES DE GERADORES ============= */
 /* ============================================== */
 
-char* gerar_temporario() {
-    char* temp = malloc(20 * sizeof(char));
-    sprintf(temp, "r%d", count_temp++);
-    return temp;
+int gerar_temporario() {
+    return count_temp++;
+}
+
+int gerar_rotulo() {
+    return count_rotulos++;
+}
+
+int novo_temporario(FuncaoILOC *f) {
+    return f->num_temps++;
 }
 
-char* gerar_rotulo() {
-    char* rotulo = malloc(20 * sizeof(char));
-    sprintf(rotulo, "L%d", count_rotulos++); // nome do temporário é L + número
-    return rotulo;
+int faixa_temporarios(const FuncaoILOC *f) {
+    return f->num_temps;
 }
 
 /* ============================================== */
 /* ======= FUNÇÕES DE CRIAÇÃO DE OPERANDOS ===== */
 /* ============================================== */
 
-OperandoILOC* criar_operando_registrador(const char *nome_reg) {
-    OperandoILOC *op = (OperandoILOC*)malloc(sizeof(OperandoILOC));
-    op->tipo = OPERAND_REGISTER;
-    op->valor.reg = strdup(nome_reg);
-    op->nome_aux = NULL;
+OperandoILOC criar_operando_registrador(int reg) {
+    OperandoILOC op = {OPERAND_REGISTER, {.reg = reg}, NULL};
     return op;
 }
 
-OperandoILOC* criar_operando_imediato(int valor) {
-    OperandoILOC *op = (OperandoILOC*)malloc(sizeof(OperandoILOC));
-    op->tipo = OPERAND_IMMEDIATE;
-    op->valor.imediato = valor;
-    op->nome_aux = NULL;
+OperandoILOC criar_operando_imediato(int valor) {
+    OperandoILOC op = {OPERAND_IMMEDIATE, {.imediato = valor}, NULL};
     return op;
 }
 
-OperandoILOC* criar_operando_rotulo(const char *nome_rotulo) {
-    OperandoILOC *op = (OperandoILOC*)malloc(sizeof(OperandoILOC));
-    op->tipo = OPERAND_LABEL;
-    op->valor.rotulo = strdup(nome_rotulo);
-    op->nome_aux = NULL;
+OperandoILOC criar_operando_rotulo(int rotulo) {
+    OperandoILOC op = {OPERAND_LABEL, {.rotulo = rotulo}, NULL};
     return op;
 }
 
-void liberar_operando(OperandoILOC *op) {
-    if (!op) return;
-    
-    if (op->tipo == OPERAND_REGISTER) {
-        free(op->valor.reg);
-    } else if (op->tipo == OPERAND_LABEL) {
-        free(op->valor.rotulo);
+/* ============================================== */
+/* ============ ARENA DE OPERAÇÕES ============== */
+/* ============================================== */
+
+/* Operações por bloco da arena */
+#define TAM_BLOCO_ARENA 4096
+
+static OperacaoILOC **arena_blocos = NULL;  // Blocos de TAM_BLOCO_ARENA operações
+static int arena_num_blocos = 0;
+static int arena_cap_blocos = 0;
+static int arena_total = 0;                 // Operações já entregues
+
+OperacaoILOC* operacao_iloc(int indice) {
+    return &arena_blocos[indice / TAM_BLOCO_ARENA][indice % TAM_BLOCO_ARENA];
+}
+
+/* Reserva a próxima posição da arena, abrindo um bloco novo quando o atual enche */
+static OperacaoILOC* nova_operacao() {
+    if (arena_total == arena_num_blocos * TAM_BLOCO_ARENA) {
+        if (arena_num_blocos == arena_cap_blocos) {
+            arena_cap_blocos = arena_cap_blocos ? arena_cap_blocos * 2 : 16;
+            arena_blocos = (OperacaoILOC**)realloc(arena_blocos, arena_cap_blocos * sizeof(OperacaoILOC*));
+        }
+        arena_blocos[arena_num_blocos++] = (OperacaoILOC*)malloc(TAM_BLOCO_ARENA * sizeof(OperacaoILOC));
     }
+    OperacaoILOC *op = operacao_iloc(arena_total);
+    op->indice = arena_total++;
+    return op;
+}
 
-    if (op->nome_aux != NULL) free(op->nome_aux);
-    free(op);
+void liberar_arena_iloc() {
+    for (int i = 0; i < arena_num_blocos; i++) free(arena_blocos[i]);
+    free(arena_blocos);
+    arena_blocos = NULL;
+    arena_num_blocos = arena_cap_blocos = arena_total = 0;
 }
 
 /* ============================================== */
@@ -102,125 +186,44 @@ void liberar_operando(OperandoILOC *op) {
 
 OperacaoILOC* criar_operacao(
     Opcode opcode,
-    OperandoILOC **fonte, int num_fonte,
-    OperandoILOC **alvo, int num_alvo
+    OperandoILOC *fonte, int num_fonte,
+    OperandoILOC *alvo, int num_alvo
 ) {
-    OperacaoILOC *op = (OperacaoILOC*)malloc(sizeof(OperacaoILOC));
+    OperacaoILOC *op = nova_operacao();
     op->opcode = opcode;
-    op->rotulo = NULL;
-    op->proximo = NULL;
+    op->rotulo = ROTULO_NENHUM;
+    op->funcao = NULL;
+    op->proximo = OPERACAO_NENHUMA;
     
+    // Operandos são valores simples (ids e ponteiros para símbolos): cópia direta
     op->num_fonte = num_fonte;
-    // Loop copiando operandos fonte
-    if (num_fonte > 0) {
-        op->operandos_fonte = (OperandoILOC*)malloc(num_fonte * sizeof(OperandoILOC));
-        for (int i = 0; i < num_fonte; i++) {
-            // Copia o tipo
-            op->operandos_fonte[i].tipo = fonte[i]->tipo;
-            
-            // Copia profundamente o valor baseado no tipo
-            if (fonte[i]->tipo == OPERAND_REGISTER) {
-                op->operandos_fonte[i].valor.reg = strdup(fonte[i]->valor.reg);
-            } else if (fonte[i]->tipo == OPERAND_LABEL) {
-                op->operandos_fonte[i].valor.rotulo = strdup(fonte[i]->valor.rotulo);
-            } else {
-                op->operandos_fonte[i].valor.imediato = fonte[i]->valor.imediato;
-            }
-
-            // Cópia do nome_aux se existir
-            if (fonte[i]->nome_aux) op->operandos_fonte[i].nome_aux = strdup(fonte[i]->nome_aux);
-            else op->operandos_fonte[i].nome_aux = NULL;
-        }
-    // Se não achou atributos fonte
-    } else {
-        op->operandos_fonte = NULL;
-    }
+    if (num_fonte > 0) memcpy(op->operandos_fonte, fonte, num_fonte * sizeof(OperandoILOC));
     
     op->num_alvo = num_alvo;
-    // Loop copiando operandos alvo
-    if (num_alvo > 0) {
-        op->operandos_alvo = (OperandoILOC*)malloc(num_alvo * sizeof(OperandoILOC));
-        for (int i = 0; i < num_alvo; i++) {
-            // Copia o tipo
-            op->operandos_alvo[i].tipo = alvo[i]->tipo;
-            
-            // Copia profundamente o valor baseado no tipo
-            if (alvo[i]->tipo == OPERAND_REGISTER) {
-                op->operandos_alvo[i].valor.reg = strdup(alvo[i]->valor.reg);
-            } else if (alvo[i]->tipo == OPERAND_LABEL) {
-                op->operandos_alvo[i].valor.rotulo = strdup(alvo[i]->valor.rotulo);
-            } else {
-                op->operandos_alvo[i].valor.imediato = alvo[i]->valor.imediato;
-            }
-            
-            // Cópia do nome_aux se existir
-            if (alvo[i]->nome_aux) op->operandos_alvo[i].nome_aux = strdup(alvo[i]->nome_aux);
-            else op->operandos_alvo[i].nome_aux = NULL;
-        }
-    // Se não achou atributos alvo
-    } else {
-        op->operandos_alvo = NULL;
-    }
+    if (num_alvo > 0) memcpy(op->operandos_alvo, alvo, num_alvo * sizeof(OperandoILOC));
     
     return op;
 }
 
 OperacaoILOC* criar_operacao_com_rotulo(
-    const char *rotulo, Opcode opcode,
-    OperandoILOC **fonte, int num_fonte,
-    OperandoILOC **alvo, int num_alvo
+    int rotulo, Opcode opcode,
+    OperandoILOC *fonte, int num_fonte,
+    OperandoILOC *alvo, int num_alvo
 ) {
     // Apenas se faz a chamada de criar_operacao com a adicao do rotulo posteriormente
     OperacaoILOC *op = criar_operacao(opcode, fonte, num_fonte, alvo, num_alvo);
-    op->rotulo = strdup(rotulo);
+    op->rotulo = rotulo;
     return op;
 }
 
-void liberar_operacao(OperacaoILOC *op) {
-    // Se não há operação retorna
-    if (!op) return;
-
-    if (op->rotulo) free(op->rotulo);
-    
-    // percorre operandos fonte fazendo limpeza
-    for (int i = 0; i < op->num_fonte; i++) {
-        if (op->operandos_fonte[i].tipo == OPERAND_REGISTER) {
-            free(op->operandos_fonte[i].valor.reg);
-        } else if (op->operandos_fonte[i].tipo == OPERAND_LABEL) {
-            free(op->operandos_fonte[i].valor.rotulo);
-        }
-
-        if (op->operandos_fonte[i].nome_aux != NULL) {
-            free(op->operandos_fonte[i].nome_aux);
-        }
-    }
-    if (op->operandos_fonte) free(op->operandos_fonte);
-    
-    // percorre operandos alvo fazendo a limpeza
-    for (int i = 0; i < op->num_alvo; i++) {
-        if (op->operandos_alvo[i].tipo == OPERAND_REGISTER) {
-            free(op->operandos_alvo[i].valor.reg);
-        } else if (op->operandos_alvo[i].tipo == OPERAND_LABEL) {
-            free(op->operandos_alvo[i].valor.rotulo);
-        }
-
-        if (op->operandos_alvo[i].nome_aux != NULL) {
-            free(op->operandos_alvo[i].nome_aux);
-        }
-    }
-    if (op->operandos_alvo) free(op->operandos_alvo);
-    
-    free(op);
-}
-
 /* ============================================== */
 /* ======== FUNÇÕES DE LISTA DE OPERAÇÕES ====== */
 /* ============================================== */
 
 ListaILOC* criar_lista_iloc() {
     ListaILOC *lista = (ListaILOC*)malloc(sizeof(ListaILOC));
-    lista->primeira = NULL;
-    lista->ultima = NULL;
+    lista->primeira = OPERACAO_NENHUMA;
+    lista->ultima = OPERACAO_NENHUMA;
     return lista;
 }
 
@@ -228,13 +231,13 @@ void adicionar_operacao(ListaILOC *lista, OperacaoILOC *op) {
     if (!lista || !op) return;
     
     // Se for primeira inserção é primeiro e último elemento
-    if (lista->primeira == NULL) {
-        lista->primeira = op;
-        lista->ultima = op;
-    // Muda fim da lista e adiciona ponteiro para operação adicionada no ultimo elemento anterior
+    if (lista->primeira == OPERACAO_NENHUMA) {
+        lista->primeira = op->indice;
+        lista->ultima = op->indice;
+    // Muda fim da lista e encadeia a operação adicionada no ultimo elemento anterior
     } else {
-        lista->ultima->proximo = op;
-        lista->ultima = op;
+        operacao_iloc(lista->ultima)->proximo = op->indice;
+        lista->ultima = op->indice;
     }
 }
 void adicionar_operacao_ini(ListaILOC *lista, OperacaoILOC *op) {
@@ -242,10 +245,10 @@ void adicionar_operacao_ini(ListaILOC *lista, OperacaoILOC *op) {
 
     op->proximo = lista->primeira; 
 
-    if (lista->primeira == NULL) {
-        lista->ultima = op;
+    if (lista->primeira == OPERACAO_NENHUMA) {
+        lista->ultima = op->indice;
     }
-    lista->primeira = op;
+    lista->primeira = op->indice;
 }
 
 ListaILOC* concatenar_listas(ListaILOC *lista1, ListaILOC *lista2, OrdemConcatenacao ordem_inv) {
@@ -254,21 +257,21 @@ ListaILOC* concatenar_listas(ListaILOC *lista1, ListaILOC *lista2, OrdemConcaten
     if (!lista1) return lista2;
     if (!lista2) return lista1;
     
-    // Se lista1 está vazia, apenas copia os ponteiros de lista2
-    if (lista1->primeira == NULL) {
+    // Se lista1 está vazia, apenas copia as pontas de lista2
+    if (lista1->primeira == OPERACAO_NENHUMA) {
         lista1->primeira = lista2->primeira;
         lista1->ultima = lista2->ultima;
     } 
     // Se lista2 não está vazia, conecta ao final de lista1
-    else if (lista2->primeira != NULL) {
+    else if (lista2->primeira != OPERACAO_NENHUMA) {
         // lista2 -> lista1
         if(ordem_inv == 1){
-            lista2->ultima->proximo = lista1->primeira; // A cauda da L2 aponta para a cabeça da L1
-            lista1->primeira = lista2->primeira;        // A nova cabeça da L1 passa a ser a cabeça da L2
+            operacao_iloc(lista2->ultima)->proximo = lista1->primeira; // A cauda da L2 aponta para a cabeça da L1
+            lista1->primeira = lista2->primeira;                       // A nova cabeça da L1 passa a ser a cabeça da L2
 
         //lista1 -> lista2
         }else{
-            lista1->ultima->proximo = lista2->primeira;
+            operacao_iloc(lista1->ultima)->proximo = lista2->primeira;
             lista1->ultima = lista2->ultima;
         }
     }
@@ -279,26 +282,41 @@ ListaILOC* concatenar_listas(ListaILOC *lista1, ListaILOC *lista2, OrdemConcaten
 }
 
 void liberar_lista_iloc(ListaILOC *lista) {
-    if (!lista) return;
-    
-    OperacaoILOC *atual = lista->primeira;
-    while (atual) {
-        OperacaoILOC *prox = atual->proximo;
-        liberar_operacao(atual);
-        atual = prox;
-    }
-    
+    // As operações são liberadas de uma vez junto com a arena
     free(lista);
 }
 
+/* Imprime um operando, formatando o nome de registradores e rótulos */
+static void imprimir_operando_iloc(OperandoILOC *op) {
+    switch (op->tipo) {
+        case OPERAND_REGISTER:
+            switch (op->valor.reg) {
+                case REG_RFP:  printf("rfp"); break;
+                case REG_RBSS: printf("rbss"); break;
+                case REG_RSP:  printf("rsp"); break;
+                default:       printf("r%d", op->valor.reg); break;
+            }
+            break;
+        case OPERAND_IMMEDIATE:
+            printf("%d", op->valor.imediato);
+            break;
+        case OPERAND_LABEL:
+            printf("L%d", op->valor.rotulo);
+            break;
+    }
+}
+
 void imprimir_codigo_iloc(ListaILOC *lista) {
     if (!lista) return;
     
-    OperacaoILOC *op = lista->primeira;
-    while (op) {
+    for (int i = lista->primeira; i != OPERACAO_NENHUMA; i = operacao_iloc(i)->proximo) {
+        OperacaoILOC *op = operacao_iloc(i);
+
         // Imprime o rótulo se existir
-        if (op->rotulo) {
-            printf("%s: ", op->rotulo);
+        if (op->funcao) {
+            printf("%s: ", nome_simbolo(op->funcao));
+        } else if (op->rotulo != ROTULO_NENHUM) {
+            printf("L%d: ", op->rotulo);
         }
         
         // Imprime o opcode
@@ -309,18 +327,7 @@ void imprimir_codigo_iloc(ListaILOC *lista) {
             printf(" ");
             for (int i = 0; i < op->num_fonte; i++) {
                 if (i > 0) printf(", ");
-                
-                switch (op->operandos_fonte[i].tipo) {
-                    case OPERAND_REGISTER:
-                        printf("%s", op->operandos_fonte[i].valor.reg);
-                        break;
-                    case OPERAND_IMMEDIATE:
-                        printf("%d", op->operandos_fonte[i].valor.imediato);
-                        break;
-                    case OPERAND_LABEL:
-                        printf("%s", op->operandos_fonte[i].valor.rotulo);
-                        break;
-                }
+                imprimir_operando_iloc(&op->operandos_fonte[i]);
             }
         }
         
@@ -335,211 +342,231 @@ void imprimir_codigo_iloc(ListaILOC *lista) {
             
             for (int i = 0; i < op->num_alvo; i++) {
                 if (i > 0) printf(", ");
-                
-                switch (op->operandos_alvo[i].tipo) {
-                    case OPERAND_REGISTER:
-                        printf("%s", op->operandos_alvo[i].valor.reg);
-                        break;
-                    case OPERAND_IMMEDIATE:
-                        printf("%d", op->operandos_alvo[i].valor.imediato);
-                        break;
-                    case OPERAND_LABEL:
-                        printf("%s", op->operandos_alvo[i].valor.rotulo);
-                        break;
-                }
+                imprimir_operando_iloc(&op->operandos_alvo[i]);
             }
         }
         
         printf("\n");
-        op = op->proximo;
     }
 }
 
+int eh_inicio_funcao(OperacaoILOC *op) {
+    return op && op->funcao != NULL;
+}
+
+int tem_rotulo(OperacaoILOC *op) {
+    return op->rotulo != ROTULO_NENHUM || op->funcao != NULL;
+}
+
+const char* nome_simbolo(struct simbolo *s) {
+    return s ? s->chave : NULL;
+}
+
+void anexar_operacao_funcao(FuncaoILOC *f, OperacaoILOC *op) {
+    if (f->num_ops == f->capacidade) {
+        f->capacidade = f->capacidade ? f->capacidade * 2 : 64;
+        f->ops = (OperacaoILOC*)realloc(f->ops, f->capacidade * sizeof(OperacaoILOC));
+    }
+    f->ops[f->num_ops] = *op;
+    f->ops[f->num_ops].proximo = OPERACAO_NENHUMA;
+    f->num_ops++;
+}
+
+FuncaoILOC* separar_funcoes(ListaILOC *lista, int *num_funcoes) {
+    *num_funcoes = 0;
+    if (!lista) return NULL;
+
+    // Primeira passada: conta as funções
+    int total = 0;
+    for (int i = lista->primeira; i != OPERACAO_NENHUMA; i = operacao_iloc(i)->proximo) {
+        if (eh_inicio_funcao(operacao_iloc(i))) total++;
+    }
+    if (total == 0) return NULL;
+
+    FuncaoILOC *funcoes = (FuncaoILOC*)calloc(total, sizeof(FuncaoILOC));
+    int atual = -1;
+
+    // Segunda passada: copia as operações para o vetor da sua função
+    for (int i = lista->primeira; i != OPERACAO_NENHUMA; i = operacao_iloc(i)->proximo) {
+        OperacaoILOC *op = operacao_iloc(i);
+        if (eh_inicio_funcao(op)) {
+            atual++;
+            funcoes[atual].nome = nome_simbolo(op->funcao);
+        }
+        // Código antes do primeiro rótulo de função não pertence a nenhuma função
+        if (atual < 0) continue;
+
+        anexar_operacao_funcao(&funcoes[atual], op);
+    }
+
+    // Renumera os temporários de cada função; dono[t] diz de qual função é
+    // o número local guardado em local[t]
+    int *local = (int*)malloc((count_temp + 1) * sizeof(int));
+    int *dono = (int*)malloc((count_temp + 1) * sizeof(int));
+    for (int t = 0; t < count_temp; t++) dono[t] = -1;
+    for (int k = 0; k < total; k++) {
+        FuncaoILOC *f = &funcoes[k];
+        for (int i = 0; i < f->num_ops; i++) {
+            OperacaoILOC *op = &f->ops[i];
+            for (int j = 0; j < op->num_fonte + op->num_alvo; j++) {
+                OperandoILOC *o = (j < op->num_fonte) ? &op->operandos_fonte[j] : &op->operandos_alvo[j - op->num_fonte];
+                if (o->tipo != OPERAND_REGISTER || o->valor.reg < 0) continue;
+                int t = o->valor.reg;
+                if (dono[t] != k) {
+                    dono[t] = k;
+                    local[t] = f->num_temps++;
+                }
+                o->valor.reg = local[t];
+            }
+        }
+    }
+    free(local);
+    free(dono);
+
+    *num_funcoes = total;
+    return funcoes;
+}
+
+void compactar_funcao(FuncaoILOC *f) {
+    int k = 0;
+    for (int i = 0; i < f->num_ops; i++) {
+        if (f->ops[i].opcode == OP_NOP && !tem_rotulo(&f->ops[i])) continue;
+        f->ops[k++] = f->ops[i];
+    }
+    f->num_ops = k;
+}
+
+void anular_operacao(OperacaoILOC *op) {
+    op->opcode = OP_NOP;
+    op->num_fonte = 0;
+    op->num_alvo = 0;
+}
+
+void liberar_funcoes(FuncaoILOC *funcoes, int num_funcoes) {
+    if (!funcoes) return;
+    for (int i = 0; i < num_funcoes; i++) free(funcoes[i].ops);
+    free(funcoes);
+}
+
 /* ============================================== */
 /* ========= FUNÇÕES AUXILIARES DE GERAÇÃO ===== */
 /* ============================================== */
 
-OperacaoILOC* criar_loadI(int valor, const char *reg_destino) {
-    OperandoILOC *fonte[1] = {criar_operando_imediato(valor)};
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_destino)};
-    
-    OperacaoILOC *op = criar_operacao(OP_LOADI, fonte, 1, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+OperacaoILOC* criar_loadI(int valor, int reg_destino) {
+    OperandoILOC fonte[1] = {criar_operando_imediato(valor)};
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_destino)};
+    return criar_operacao(OP_LOADI, fonte, 1, alvo, 1);
 }
 
-OperacaoILOC* criar_load(const char *reg_origem, const char *reg_destino) {
-    OperandoILOC *fonte[1] = {criar_operando_registrador(reg_origem)};
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_destino)};
-    
-    OperacaoILOC *op = criar_operacao(OP_LOAD, fonte, 1, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+OperacaoILOC* criar_load(int reg_origem, int reg_destino) {
+    OperandoILOC fonte[1] = {criar_operando_registrador(reg_origem)};
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_destino)};
+    return criar_operacao(OP_LOAD, fonte, 1, alvo, 1);
 }
 
-OperacaoILOC* criar_loadAI(const char *reg_base, int offset, const char *reg_destino, const char *nome_global) {
-    OperandoILOC *fonte[2] = {
+OperacaoILOC* criar_loadAI(int reg_base, int offset, int reg_destino, struct simbolo *global) {
+    OperandoILOC fonte[2] = {
         criar_operando_registrador(reg_base),
         criar_operando_imediato(offset)
     };
 
-    // Anexa o nome ao operando imediato (o offset)
-    if (nome_global) fonte[1]->nome_aux = strdup(nome_global);
+    // Anexa o símbolo ao operando imediato (o offset)
+    fonte[1].simbolo = global;
 
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_destino)};
-    
-    OperacaoILOC *op = criar_operacao(OP_LOADAI, fonte, 2, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(fonte[1]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_destino)};
+    return criar_operacao(OP_LOADAI, fonte, 2, alvo, 1);
 }
 
-OperacaoILOC* criar_store(const char *reg_origem, const char *reg_destino) {
-    OperandoILOC *fonte[1] = {criar_operando_registrador(reg_origem)};
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_destino)};
-    
-    OperacaoILOC *op = criar_operacao(OP_STORE, fonte, 1, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+OperacaoILOC* criar_store(int reg_origem, int reg_destino) {
+    OperandoILOC fonte[1] = {criar_operando_registrador(reg_origem)};
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_destino)};
+    return criar_operacao(OP_STORE, fonte, 1, alvo, 1);
 }
 
-OperacaoILOC* criar_storeAI(const char *reg_origem, const char *reg_base, int offset, const char *nome_global) {
-    OperandoILOC *fonte[1] = {criar_operando_registrador(reg_origem)};
-    OperandoILOC *alvo[2] = {
+OperacaoILOC* criar_storeAI(int reg_origem, int reg_base, int offset, struct simbolo *global) {
+    OperandoILOC fonte[1] = {criar_operando_registrador(reg_origem)};
+    OperandoILOC alvo[2] = {
         criar_operando_registrador(reg_base),
         criar_operando_imediato(offset)
     };
 
-    // Anexa o nome ao operando imediato (o offset)
-    if (nome_global) alvo[1]->nome_aux = strdup(nome_global);
-    
-    OperacaoILOC *op = criar_operacao(OP_STOREAI, fonte, 1, alvo, 2);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(alvo[0]);
-    liberar_operando(alvo[1]);
-    
-    return op;
+    // Anexa o símbolo ao operando imediato (o offset)
+    alvo[1].simbolo = global;
+
+    return criar_operacao(OP_STOREAI, fonte, 1, alvo, 2);
 }
 
-OperacaoILOC* criar_aritmetica(Opcode opcode, const char *reg1, const char *reg2, const char *reg_dest) {
-    OperandoILOC *fonte[2] = {
+OperacaoILOC* criar_aritmetica(Opcode opcode, int reg1, int reg2, int reg_dest) {
+    OperandoILOC fonte[2] = {
         criar_operando_registrador(reg1),
         criar_operando_registrador(reg2)
     };
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_dest)};
-    
-    OperacaoILOC *op = criar_operacao(opcode, fonte, 2, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(fonte[1]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_dest)};
+    return criar_operacao(opcode, fonte, 2, alvo, 1);
 }
 
-OperacaoILOC* criar_aritmetica_imediata(Opcode opcode, const char *reg, int imediato, const char *reg_dest) {
-    OperandoILOC *fonte[2] = {
+OperacaoILOC* criar_aritmetica_imediata(Opcode opcode, int reg, int imediato, int reg_dest) {
+    OperandoILOC fonte[2] = {
         criar_operando_registrador(reg),
         criar_operando_imediato(imediato)
     };
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_dest)};
-    
-    OperacaoILOC *op = criar_operacao(opcode, fonte, 2, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(fonte[1]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_dest)};
+    return criar_operacao(opcode, fonte, 2, alvo, 1);
 }
 
-OperacaoILOC* criar_rsubI(int valor, const char *reg_origem, const char *reg_destino) {
-    OperandoILOC *fonte[2] = {
+OperacaoILOC* criar_rsubI(int valor, int reg_origem, int reg_destino) {
+    OperandoILOC fonte[2] = {
         criar_operando_registrador(reg_origem),
         criar_operando_imediato(valor)
     };
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_destino)};
-    
-    OperacaoILOC *op = criar_operacao(OP_RSUBI, fonte, 2, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(fonte[1]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_destino)};
+    return criar_operacao(OP_RSUBI, fonte, 2, alvo, 1);
 }
 
-OperacaoILOC* criar_comparacao(Opcode opcode, const char *reg1, const char *reg2, const char *reg_dest) {
-    OperandoILOC *fonte[2] = {
+OperacaoILOC* criar_comparacao(Opcode opcode, int reg1, int reg2, int reg_dest) {
+    OperandoILOC fonte[2] = {
         criar_operando_registrador(reg1),
         criar_operando_registrador(reg2)
     };
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_dest)};
-    
-    OperacaoILOC *op = criar_operacao(opcode, fonte, 2, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(fonte[1]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_dest)};
+    return criar_operacao(opcode, fonte, 2, alvo, 1);
 }
 
-OperacaoILOC* criar_cbr(const char *reg_condicao, const char *rotulo_true, const char *rotulo_false) {
-    OperandoILOC *fonte[1] = {criar_operando_registrador(reg_condicao)};
-    OperandoILOC *alvo[2] = {
+OperacaoILOC* criar_cbr(int reg_condicao, int rotulo_true, int rotulo_false) {
+    OperandoILOC fonte[1] = {criar_operando_registrador(reg_condicao)};
+    OperandoILOC alvo[2] = {
         criar_operando_rotulo(rotulo_true),
         criar_operando_rotulo(rotulo_false)
     };
-    
-    OperacaoILOC *op = criar_operacao(OP_CBR, fonte, 1, alvo, 2);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(alvo[0]);
-    liberar_operando(alvo[1]);
-    
-    return op;
+    return criar_operacao(OP_CBR, fonte, 1, alvo, 2);
 }
 
-OperacaoILOC* criar_jumpI(const char *rotulo) {
-    OperandoILOC *alvo[1] = {criar_operando_rotulo(rotulo)};
-    
-    OperacaoILOC *op = criar_operacao(OP_JUMPI, NULL, 0, alvo, 1);
-    
-    liberar_operando(alvo[0]);
-    
-    return op;
+OperacaoILOC* criar_jumpI(int rotulo) {
+    OperandoILOC alvo[1] = {criar_operando_rotulo(rotulo)};
+    return criar_operacao(OP_JUMPI, NULL, 0, alvo, 1);
 }
 
-OperacaoILOC* criar_i2i(const char *reg_origem, const char *reg_destino) {
-    OperandoILOC *fonte[1] = {criar_operando_registrador(reg_origem)};
-    OperandoILOC *alvo[1] = {criar_operando_registrador(reg_destino)};
-    
-    OperacaoILOC *op = criar_operacao(OP_I2I, fonte, 1, alvo, 1);
-    
-    liberar_operando(fonte[0]);
-    liberar_operando(alvo[0]);
-    
-    return op;
+OperacaoILOC* criar_i2i(int reg_origem, int reg_destino) {
+    OperandoILOC fonte[1] = {criar_operando_registrador(reg_origem)};
+    OperandoILOC alvo[1] = {criar_operando_registrador(reg_destino)};
+    return criar_operacao(OP_I2I, fonte, 1, alvo, 1);
+}
+
+OperacaoILOC* criar_ret(int reg) {
+    OperandoILOC fonte[1] = {criar_operando_registrador(reg)};
+    return criar_operacao(OP_RET, fonte, 1, NULL, 0);
 }
 
 OperacaoILOC* criar_nop() {
     return criar_operacao(OP_NOP, NULL, 0, NULL, 0);
 }
 
-OperacaoILOC* criar_nop_com_rotulo(const char *rotulo) {
+OperacaoILOC* criar_nop_com_rotulo(int rotulo) {
     return criar_operacao_com_rotulo(rotulo, OP_NOP, NULL, 0, NULL, 0);
-}
\ No newline at end of file
+}
+
+OperacaoILOC* criar_inicio_funcao(struct simbolo *funcao) {
+    OperacaoILOC *op = criar_nop();
+    op->funcao = funcao;
+    return op;
+}
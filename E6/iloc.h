@@ -10,9 +10,12 @@ typedef enum {
     OP_NOP = 0,
     OP_ADD, OP_SUB, OP_MULT, OP_DIV,
     OP_RSUBI,
+    OP_ADDI, OP_SUBI, OP_MULTI, OP_DIVI,
+    OP_LSHIFTI, OP_RSHIFTI,
     
     // Lógica
     OP_AND, OP_OR, OP_XOR,
+    OP_ANDI, OP_ORI, OP_XORI,
     
     // Memória
     OP_LOAD, OP_LOADAI, OP_LOADI,
@@ -39,60 +42,112 @@ typedef enum {
     OPERAND_LABEL       // Rótulo (L0, L1, etc)
 } TipoOperando;
 
+/* Registradores são ids inteiros: temporários são >= 0 (impressos como r<id>)
+   e os especiais são negativos. Os nomes só são formatados na impressão. */
+#define REG_NENHUM  -1      // Nó sem temporário (ex.: chamada sem código)
+#define REG_RFP     -2      // Base do frame (variáveis locais)
+#define REG_RBSS    -3      // Base do segmento de dados (variáveis globais)
+#define REG_RSP     -4
+
+/* Rótulos gerados são ids >= 0 (impressos como L<id>) */
+#define ROTULO_NENHUM -1
+
+/* Entrada da tabela de símbolos (tabelaSimbolos.h) */
+struct simbolo;
+
 typedef struct operando_iloc {
     TipoOperando tipo;
     union {
-        char *reg;      // Nome do registrador
+        int reg;        // Id do registrador
         int imediato;   // Valor imediato
-        char *rotulo;   // Nome do rótulo
+        int rotulo;     // Id do rótulo
     } valor;
-    char *nome_aux;
+    struct simbolo *simbolo;    // Variável global acessada via rbss (ou NULL)
 } OperandoILOC;
 
+/* Nenhuma instrução ILOC tem mais de dois operandos de cada lado,
+   então eles ficam guardados dentro da própria operação */
+#define MAX_OPERANDOS 2
+
+/* Índice que encerra um encadeamento de operações */
+#define OPERACAO_NENHUMA -1
+
 typedef struct operacao_iloc {
     Opcode opcode;                  // Código da operação (add, sub, load, etc)
-    OperandoILOC *operandos_fonte;  // Array de operandos fonte
+    OperandoILOC operandos_fonte[MAX_OPERANDOS];   // Operandos fonte
     int num_fonte;                  // Número de operandos fonte
-    OperandoILOC *operandos_alvo;   // Array de operandos alvo
+    OperandoILOC operandos_alvo[MAX_OPERANDOS];    // Operandos alvo
     int num_alvo;                   // Número de operandos alvo
-    char *rotulo;                   // Rótulo opcional desta instrução
-    struct operacao_iloc *proximo;  // Próxima operação na lista
+    int rotulo;                     // Rótulo gerado desta instrução (ou ROTULO_NENHUM)
+    struct simbolo *funcao;         // Função que começa nesta instrução (ou NULL)
+    int indice;                     // Posição desta operação na arena
+    int proximo;                    // Índice da próxima operação na lista (ou OPERACAO_NENHUMA)
 } OperacaoILOC;
 
-/* Estrutura para lista de operações ILOC */
+/* Lista de operações ILOC: um trecho encadeado por índices dentro da arena.
+   Concatenar só religa os índices das pontas, sem copiar operações. */
 typedef struct lista_iloc {
-    OperacaoILOC *primeira;
-    OperacaoILOC *ultima;
+    int primeira;
+    int ultima;
 } ListaILOC;
 
+/* Trecho do programa correspondente a uma única função */
+typedef struct funcao_iloc {
+    const char *nome;       // Nome da função (chave na tabela de símbolos)
+    OperacaoILOC *ops;      // Operações da função, contíguas e na ordem da lista
+    int num_ops;            // Número de operações
+    int capacidade;         // Espaço reservado em ops
+    int num_temps;          // Temporários numerados densamente em [0, num_temps)
+} FuncaoILOC;
+
 /* Função auxiliar para debug/impressão */
 const char* nome_opcode(Opcode op);
 
+/* Forma com imediato de uma operação entre registradores (add -> addI),
+   ou OP_NOP se ela não tem essa forma */
+Opcode opcode_imediato(Opcode op);
+
+/* Operação entre registradores equivalente à forma com imediato
+   (addI -> add); as demais, inclusive rsubI e os shifts, voltam iguais */
+Opcode opcode_registrador(Opcode op);
+
+/* Avalia a operação sobre os valores a e b em tempo de compilação, com a
+   aritmética de 32 bits do alvo (transbordo circular, comparações valendo
+   0 ou 1). Devolve 0 quando o resultado não é uma constante (divisão por
+   zero, INT_MIN / -1 ou opcode sem valor). */
+int avaliar_constante(Opcode opcode, int a, int b, int *resultado);
+
 /* ============================================== */
 /* =========== FUNÇÕES DE GERADORES ============= */
 /* ============================================== */
 
-/* Gera um novo nome de registrador temporário */
-char* gerar_temporario();
+/* Gera um novo registrador temporário (id) */
+int gerar_temporario();
+
+/* Gera um novo rótulo (id) */
+int gerar_rotulo();
+
+/* Gera um novo temporário local à função, logo após os que ela já usa */
+int novo_temporario(FuncaoILOC *f);
 
-/* Gera um novo nome de rótulo */
-char* gerar_rotulo();
+/* Faixa dos temporários da função: todos os seus ids ficam em [0, faixa).
+   Os passes dimensionam por ela as tabelas indexadas por temporário. */
+int faixa_temporarios(const FuncaoILOC *f);
 
 /* ============================================== */
 /* ======== FUNÇÕES DE CRIAÇÃO DE OPERANDOS ===== */
 /* ============================================== */
 
+/* Operandos são valores pequenos: criados na pilha e copiados na operação */
+
 /* Cria um operando do tipo registrador */
-OperandoILOC* criar_operando_registrador(const char *nome_reg);
+OperandoILOC criar_operando_registrador(int reg);
 
 /* Cria um operando do tipo imediato */
-OperandoILOC* criar_operando_imediato(int valor);
+OperandoILOC criar_operando_imediato(int valor);
 
 /* Cria um operando do tipo rótulo */
-OperandoILOC* criar_operando_rotulo(const char *nome_rotulo);
-
-/* Libera um operando */
-void liberar_operando(OperandoILOC *op);
+OperandoILOC criar_operando_rotulo(int rotulo);
 
 /* ============================================== */
 /* ======= FUNÇÕES DE CRIAÇÃO DE OPERAÇÕES ===== */
@@ -100,16 +155,27 @@ void liberar_operando(OperandoILOC *op);
 
 /* Cria uma operação ILOC básica */
 OperacaoILOC* criar_operacao(Opcode opcode, 
-                             OperandoILOC **fonte, int num_fonte,
-                             OperandoILOC **alvo, int num_alvo);
+                             OperandoILOC *fonte, int num_fonte,
+                             OperandoILOC *alvo, int num_alvo);
 
 /* Cria operação com rótulo */
-OperacaoILOC* criar_operacao_com_rotulo(const char *rotulo, Opcode opcode,
-                                        OperandoILOC **fonte, int num_fonte,
-                                        OperandoILOC **alvo, int num_alvo);
+OperacaoILOC* criar_operacao_com_rotulo(int rotulo, Opcode opcode,
+                                        OperandoILOC *fonte, int num_fonte,
+                                        OperandoILOC *alvo, int num_alvo);
+
+/* ============================================== */
+/* ============ ARENA DE OPERAÇÕES ============== */
+/* ============================================== */
+
+/* Todas as operações do programa moram numa arena de blocos de tamanho
+   fixo: os blocos nunca são realocados, então ponteiros para operações
+   continuam válidos enquanto a árvore é construída. */
+
+/* Operação guardada na posição indicada da arena */
+OperacaoILOC* operacao_iloc(int indice);
 
-/* Libera uma operação */
-void liberar_operacao(OperacaoILOC *op);
+/* Libera todas as operações da arena (depois de liberar as listas) */
+void liberar_arena_iloc();
 
 /* ============================================== */
 /* ======== FUNÇÕES DE LISTA DE OPERAÇÕES ====== */
@@ -128,54 +194,89 @@ void adicionar_operacao_ini(ListaILOC *lista, OperacaoILOC *op);
 /* se ordem_inv == 1, então lista1 é adicionada ao fim de lista2*/
 ListaILOC* concatenar_listas(ListaILOC *lista1, ListaILOC *lista2, OrdemConcatenacao ordem_inv);
 
-/* Libera toda a lista */
+/* Libera a lista (as operações pertencem à arena) */
 void liberar_lista_iloc(ListaILOC *lista);
 
 /* Imprime a lista de operações ILOC */
 void imprimir_codigo_iloc(ListaILOC *lista);
 
+/* Indica se a operação inicia uma função (rótulo de função, não um L gerado) */
+int eh_inicio_funcao(OperacaoILOC *op);
+
+/* Indica se a operação tem rótulo (gerado ou de função) */
+int tem_rotulo(OperacaoILOC *op);
+
+/* Nome de uma entrada da tabela de símbolos (global ou função) */
+const char* nome_simbolo(struct simbolo *s);
+
+/* Separa a lista do programa em funções. Cada função recebe um vetor
+   contíguo com cópias das suas operações, que o backend pode reordenar
+   e reescrever sem mexer na lista. Os temporários de cada função são
+   renumerados densamente a partir de 0, para que as tabelas dos passes
+   tenham o tamanho da função e não do programa. */
+FuncaoILOC* separar_funcoes(ListaILOC *lista, int *num_funcoes);
+
+/* Acrescenta uma cópia da operação ao fim do vetor da função */
+void anexar_operacao_funcao(FuncaoILOC *f, OperacaoILOC *op);
+
+/* Remove do vetor da função os nops sem rótulo (restos de passes que
+   apagam operações substituindo-as por nop) */
+void compactar_funcao(FuncaoILOC *f);
+
+/* Transforma a operação num nop, preservando o rótulo dela */
+void anular_operacao(OperacaoILOC *op);
+
+/* Libera os vetores criados por separar_funcoes */
+void liberar_funcoes(FuncaoILOC *funcoes, int num_funcoes);
+
 /* ============================================== */
 /* ========= FUNÇÕES AUXILIARES DE GERAÇÃO ===== */
 /* ============================================== */
 
 /* Cria operação loadI (carrega imediato em registrador) */
-OperacaoILOC* criar_loadI(int valor, const char *reg_destino);
+OperacaoILOC* criar_loadI(int valor, int reg_destino);
 
 /* Cria operação load (carrega de memória) */
-OperacaoILOC* criar_load(const char *reg_origem, const char *reg_destino);
+OperacaoILOC* criar_load(int reg_origem, int reg_destino);
 
-/* Cria operação loadAI (carrega com offset) */
-OperacaoILOC* criar_loadAI(const char *reg_base, int offset, const char *reg_destino, const char *nome_global);
+/* Cria operação loadAI (carrega com offset); global é o símbolo quando a base é rbss */
+OperacaoILOC* criar_loadAI(int reg_base, int offset, int reg_destino, struct simbolo *global);
 
 /* Cria operação store (armazena em memória) */
-OperacaoILOC* criar_store(const char *reg_origem, const char *reg_destino);
+OperacaoILOC* criar_store(int reg_origem, int reg_destino);
 
-/* Cria operação storeAI (armazena com offset) */
-OperacaoILOC* criar_storeAI(const char *reg_origem, const char *reg_base, int offset, const char *nome_global);
+/* Cria operação storeAI (armazena com offset); global é o símbolo quando a base é rbss */
+OperacaoILOC* criar_storeAI(int reg_origem, int reg_base, int offset, struct simbolo *global);
 
 /* Cria operação aritmética binária (add, sub, mult, div) */
-OperacaoILOC* criar_aritmetica(Opcode opcode, const char *reg1, const char *reg2, const char *reg_dest);
+OperacaoILOC* criar_aritmetica(Opcode opcode, int reg1, int reg2, int reg_dest);
 
 /* Cria operação aritmética com imediato */
-OperacaoILOC* criar_aritmetica_imediata(Opcode opcode, const char *reg, int imediato, const char *reg_dest);
+OperacaoILOC* criar_aritmetica_imediata(Opcode opcode, int reg, int imediato, int reg_dest);
 
-OperacaoILOC* criar_rsubI(int valor, const char *reg_origem, const char *reg_destino);
+OperacaoILOC* criar_rsubI(int valor, int reg_origem, int reg_destino);
 
 /* Cria operação de comparação */
-OperacaoILOC* criar_comparacao(Opcode opcode, const char *reg1, const char *reg2, const char *reg_dest);
+OperacaoILOC* criar_comparacao(Opcode opcode, int reg1, int reg2, int reg_dest);
 
 /* Cria operação de salto condicional (cbr) */
-OperacaoILOC* criar_cbr(const char *reg_condicao, const char *rotulo_true, const char *rotulo_false);
+OperacaoILOC* criar_cbr(int reg_condicao, int rotulo_true, int rotulo_false);
 
 /* Cria operação de salto incondicional (jumpI) */
-OperacaoILOC* criar_jumpI(const char *rotulo);
+OperacaoILOC* criar_jumpI(int rotulo);
+
+OperacaoILOC* criar_i2i(int reg_origem, int reg_destino);
 
-OperacaoILOC* criar_i2i(const char *reg_origem, const char *reg_destino);
+/* Cria operação de retorno */
+OperacaoILOC* criar_ret(int reg);
 
 /* Cria operação nop */
 OperacaoILOC* criar_nop();
 
 /* Cria operação nop com rótulo */
-OperacaoILOC* criar_nop_com_rotulo(const char *rotulo);
+OperacaoILOC* criar_nop_com_rotulo(int rotulo);
+
+/* Cria o nop que marca o início de uma função */
+OperacaoILOC* criar_inicio_funcao(struct simbolo *funcao);
 
 #endif // _ILOC_H_
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "layout.h"
+#include "cfg.h"
+
+void ordenar_blocos(FuncaoILOC *funcao) {
+    int n = funcao->num_ops;
+    if (n == 0) return;
+
+    CFG *cfg = construir_cfg(funcao);
+    BlocoBasico *blocos = cfg->blocos;
+    int total = cfg->num_blocos;
+
+    // Blocos inalcançáveis não são emitidos: contam como já colocados
+    int *colocado = (int*)calloc(total, sizeof(int));
+    for (int b = 0; b < total; b++) colocado[b] = (blocos[b].rpo < 0);
+
+    // Um bloco só pode começar uma cadeia se nenhum bloco emitido cai nele
+    int *recebe_queda = (int*)calloc(total, sizeof(int));
+    for (int b = 1; b < total; b++) recebe_queda[b] = blocos[b - 1].cai && blocos[b - 1].rpo >= 0;
+    int *ordem = (int*)malloc(total * sizeof(int));
+    int num_ordem = 0;
+    int proximo_livre = 0;
+    int atual = 0;
+
+    while (atual >= 0) {
+        // Coloca a cadeia inteira de blocos que caem um no outro
+        int b = atual;
+        colocado[b] = 1;
+        ordem[num_ordem++] = b;
+        while (blocos[b].cai) {
+            b++;
+            colocado[b] = 1;
+            ordem[num_ordem++] = b;
+        }
+
+        // Escolhe o sucessor a ser colocado em seguida (vira fall-through).
+        // O fim da cadeia termina em desvio, então os sucessores são seus alvos:
+        // no cbr, o verdadeiro primeiro (corpo do laço / bloco do if)
+        atual = -1;
+        for (int k = 0; k < blocos[b].num_sucessores && atual < 0; k++) {
+            int c = blocos[b].sucessores[k];
+            if (c >= 0 && !colocado[c] && !recebe_queda[c]) atual = c;
+        }
+
+        // Sem sucessor disponível: próxima cadeia na ordem original
+        if (atual < 0) {
+            while (proximo_livre < total &&
+                   (colocado[proximo_livre] || recebe_queda[proximo_livre])) {
+                proximo_livre++;
+            }
+            if (proximo_livre < total) atual = proximo_livre;
+        }
+    }
+
+    // Reescreve o vetor de operações na nova ordem
+    OperacaoILOC *ops = (OperacaoILOC*)malloc(n * sizeof(OperacaoILOC));
+    int k = 0;
+    for (int j = 0; j < num_ordem; j++) {
+        int tam = blocos[ordem[j]].fim - blocos[ordem[j]].inicio + 1;
+        memcpy(&ops[k], &funcao->ops[blocos[ordem[j]].inicio], tam * sizeof(OperacaoILOC));
+        k += tam;
+    }
+    free(funcao->ops);
+    funcao->ops = ops;
+    funcao->num_ops = k;
+    funcao->capacidade = n;
+
+    free(recebe_queda);
+    free(ordem);
+    free(colocado);
+    liberar_cfg(cfg);
+}
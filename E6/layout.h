@@ -0,0 +1,17 @@
+#ifndef _LAYOUT_H_
+#define _LAYOUT_H_
+
+#include "iloc.h"
+
+/* ============================================== */
+/* ========== LAYOUT DE BLOCOS BÁSICOS ========== */
+/* ============================================== */
+
+/* Reordena os blocos básicos da função (o vetor ops) para maximizar os
+   fall-throughs: o alvo de cada desvio é posto logo após quem salta para
+   ele sempre que possível. Blocos que já caem no seguinte continuam colados
+   e blocos inalcançáveis a partir da entrada são descartados.
+   A lista ILOC original não é alterada. */
+void ordenar_blocos(FuncaoILOC *funcao);
+
+#endif // _LAYOUT_H_
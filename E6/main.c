@@ -5,8 +5,10 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "asd.h"
 #include "assembly.h"
+#include "passes.h"
 #include "semantica.h"
 
 extern int yyparse(void);
@@ -15,13 +17,40 @@ asd_tree_t *arvore = NULL;
 
 int main (int argc, char **argv)
 {
+  /* Opções: -O0, -O1 (padrão) e -O2 escolhem a sequência de passes, e -O2
+     troca a varredura linear pela coloração de grafo; -passes=a,b,c impõe
+     outra sequência; -time-passes mede cada passe; -fomit-frame-pointer
+     endereça o frame por %rsp e libera %rbp */
+  const char *lista_passes = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-O2") == 0) {
+      modo_alocacao = ALOC_GRAFO;
+      definir_nivel_otimizacao(2);
+    } else if (strcmp(argv[i], "-O0") == 0 || strcmp(argv[i], "-O1") == 0) {
+      modo_alocacao = ALOC_LINEAR;
+      definir_nivel_otimizacao(argv[i][2] - '0');
+    } else if (strncmp(argv[i], "-passes=", 8) == 0) {
+      lista_passes = argv[i] + 8;
+    } else if (strcmp(argv[i], "-time-passes") == 0) {
+      medir_passes = 1;
+    } else if (strcmp(argv[i], "-fomit-frame-pointer") == 0) {
+      omitir_frame_pointer = 1;
+    } else {
+      fprintf(stderr, "Opção desconhecida: %s\n", argv[i]);
+      return 1;
+    }
+  }
+  if (lista_passes && !definir_sequencia_passes(lista_passes)) return 1;
+
   int ret = yyparse();
   // asd_print_graphviz(arvore); // Descomente para imprimir a árvore em .dot
 
   if (ret == 0 && arvore != NULL) {
       gerar_assembly(arvore);
       asd_free(arvore);
+      if (medir_passes) imprimir_estatisticas_passes();
   }
+  liberar_arena_iloc();
 
   semantica_pop_scope();
 
@@ -0,0 +1,1169 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "otimizacao.h"
+#include "fluxo.h"
+#include "uthash.h"
+
+/* ================================================================= */
+/* ==================== FUNÇÕES AUXILIARES ========================= */
+/* ================================================================= */
+
+/* Temporário escrito pela operação, ou REG_NENHUM (store e desvios não
+   definem nada: seus alvos são endereços e rótulos) */
+static int temp_definido(OperacaoILOC *op) {
+    if (op->opcode == OP_STORE || op->opcode == OP_STOREAI) return REG_NENHUM;
+    if (op->num_alvo == 0 || op->operandos_alvo[0].tipo != OPERAND_REGISTER) return REG_NENHUM;
+    return op->operandos_alvo[0].valor.reg >= 0 ? op->operandos_alvo[0].valor.reg : REG_NENHUM;
+}
+
+static void reescrever_loadI(OperacaoILOC *op, int valor, int destino) {
+    op->opcode = OP_LOADI;
+    op->operandos_fonte[0] = criar_operando_imediato(valor);
+    op->num_fonte = 1;
+    op->operandos_alvo[0] = criar_operando_registrador(destino);
+    op->num_alvo = 1;
+}
+
+static void reescrever_jumpI(OperacaoILOC *op, int rotulo) {
+    op->opcode = OP_JUMPI;
+    op->num_fonte = 0;
+    op->operandos_alvo[0] = criar_operando_rotulo(rotulo);
+    op->num_alvo = 1;
+}
+
+/* ================================================================= */
+/* ============ PROPAGAÇÃO DE CONSTANTES (SCCP) ==================== */
+/* ================================================================= */
+
+/* Reticulado de cada temporário: ainda sem valor conhecido, uma constante
+   ou variável. Os valores só descem, então cada temporário muda no máximo
+   duas vezes e cada aresta vira executável uma vez. */
+typedef enum {
+    VALOR_INDEFINIDO = 0,
+    VALOR_CONSTANTE,
+    VALOR_VARIAVEL
+} NivelValor;
+
+typedef struct sccp {
+    FuncaoILOC *f;
+    FormaSSA *ssa;
+    CFG *cfg;
+    int faixa;                  // Temporários [0, faixa)
+    int *nivel, *valor;         // Por temporário
+    int *inicio_usos, *usos;    // Leitores de cada temporário: op i ou num_ops + phi
+    char *bloco_executavel;
+    char *aresta_executavel;    // Por bloco b e sucessor k: posição 2b + k
+    int *lista_arestas, num_lista_arestas;
+    int *lista_temps, num_lista_temps;
+} SCCP;
+
+/* Temporário lido como operando, ou -1 para registrador especial (variável) */
+static int indice_temp(SCCP *s, int reg) {
+    return (reg >= 0 && reg < s->faixa) ? reg : -1;
+}
+
+static void ler_operando(SCCP *s, OperandoILOC *o, int *nivel, int *valor) {
+    if (o->tipo == OPERAND_IMMEDIATE) {
+        *nivel = VALOR_CONSTANTE;
+        *valor = o->valor.imediato;
+        return;
+    }
+    int id = (o->tipo == OPERAND_REGISTER) ? indice_temp(s, o->valor.reg) : -1;
+    if (id < 0) {
+        *nivel = VALOR_VARIAVEL;
+        return;
+    }
+    *nivel = s->nivel[id];
+    *valor = s->valor[id];
+}
+
+/* Desce o temporário no reticulado (duas constantes diferentes dão variável) */
+static void rebaixar(SCCP *s, int reg, int nivel, int valor) {
+    int id = indice_temp(s, reg);
+    if (id < 0 || nivel == VALOR_INDEFINIDO || s->nivel[id] == VALOR_VARIAVEL) return;
+    if (s->nivel[id] == VALOR_CONSTANTE) {
+        if (nivel == VALOR_CONSTANTE && valor == s->valor[id]) return;
+        nivel = VALOR_VARIAVEL;
+    }
+    s->nivel[id] = nivel;
+    s->valor[id] = valor;
+    s->lista_temps[s->num_lista_temps++] = id;
+}
+
+static void marcar_aresta(SCCP *s, int b, int k) {
+    int a = 2 * b + k;
+    if (s->aresta_executavel[a]) return;
+    s->aresta_executavel[a] = 1;
+    s->lista_arestas[s->num_lista_arestas++] = a;
+}
+
+static int aresta_executavel(SCCP *s, int de, int para) {
+    BlocoBasico *bl = &s->cfg->blocos[de];
+    for (int k = 0; k < bl->num_sucessores; k++) {
+        if (bl->sucessores[k] == para && s->aresta_executavel[2 * de + k]) return 1;
+    }
+    return 0;
+}
+
+/* Sucessor do bloco que começa no rótulo (posição em sucessores[]) */
+static int sucessor_do_rotulo(SCCP *s, int b, int rotulo) {
+    BlocoBasico *bl = &s->cfg->blocos[b];
+    for (int k = 0; k < bl->num_sucessores; k++) {
+        if (s->f->ops[s->cfg->blocos[bl->sucessores[k]].inicio].rotulo == rotulo) return k;
+    }
+    return -1;
+}
+
+static void avaliar_phi(SCCP *s, Phi *phi) {
+    if (phi->destino == REG_NENHUM) return;
+    int nivel = VALOR_INDEFINIDO, valor = 0;
+    for (int a = 0; a < phi->num_argumentos && nivel != VALOR_VARIAVEL; a++) {
+        if (phi->argumentos[a] == REG_NENHUM) continue;
+        if (!aresta_executavel(s, phi->predecessores[a], phi->bloco)) continue;
+        OperandoILOC arg = criar_operando_registrador(phi->argumentos[a]);
+        int n, v = 0;
+        ler_operando(s, &arg, &n, &v);
+        if (n == VALOR_INDEFINIDO) continue;
+        if (nivel == VALOR_INDEFINIDO || n == VALOR_VARIAVEL) {
+            nivel = n;
+            valor = v;
+        } else if (v != valor) {
+            nivel = VALOR_VARIAVEL;
+        }
+    }
+    rebaixar(s, phi->destino, nivel, valor);
+}
+
+static void avaliar_operacao(SCCP *s, int i) {
+    OperacaoILOC *op = &s->f->ops[i];
+    int b = s->cfg->bloco_da_op[i];
+    int na = VALOR_VARIAVEL, nb = VALOR_CONSTANTE, va = 0, vb = 0;
+
+    if (op->opcode == OP_CBR) {
+        ler_operando(s, &op->operandos_fonte[0], &na, &va);
+        if (na == VALOR_CONSTANTE) {
+            int k = sucessor_do_rotulo(s, b, op->operandos_alvo[va ? 0 : 1].valor.rotulo);
+            if (k >= 0) marcar_aresta(s, b, k);
+        } else if (na == VALOR_VARIAVEL) {
+            for (int k = 0; k < s->cfg->blocos[b].num_sucessores; k++) marcar_aresta(s, b, k);
+        }
+        return;
+    }
+
+    int destino = temp_definido(op);
+    if (destino == REG_NENHUM) return;
+
+    switch (op->opcode) {
+        case OP_LOADI: case OP_I2I:
+        case OP_ADD: case OP_SUB: case OP_MULT: case OP_DIV: case OP_RSUBI:
+        case OP_ADDI: case OP_SUBI: case OP_MULTI: case OP_DIVI:
+        case OP_LSHIFTI: case OP_RSHIFTI:
+        case OP_AND: case OP_OR: case OP_XOR:
+        case OP_ANDI: case OP_ORI: case OP_XORI:
+        case OP_CMP_LT: case OP_CMP_LE: case OP_CMP_EQ:
+        case OP_CMP_GE: case OP_CMP_GT: case OP_CMP_NE:
+            ler_operando(s, &op->operandos_fonte[0], &na, &va);
+            if (op->num_fonte > 1) ler_operando(s, &op->operandos_fonte[1], &nb, &vb);
+            break;
+        default:
+            break;  // Cargas da memória: variável
+    }
+
+    // x * 0 e x & 0 são 0 mesmo com x desconhecido
+    Opcode base = opcode_registrador(op->opcode);
+    if ((base == OP_MULT || base == OP_AND) &&
+        ((na == VALOR_CONSTANTE && va == 0) || (nb == VALOR_CONSTANTE && vb == 0))) {
+        rebaixar(s, destino, VALOR_CONSTANTE, 0);
+        return;
+    }
+
+    int resultado;
+    if (na == VALOR_VARIAVEL || nb == VALOR_VARIAVEL) {
+        rebaixar(s, destino, VALOR_VARIAVEL, 0);
+    } else if (na == VALOR_CONSTANTE && nb == VALOR_CONSTANTE) {
+        if (avaliar_constante(op->opcode, va, vb, &resultado)) rebaixar(s, destino, VALOR_CONSTANTE, resultado);
+        else rebaixar(s, destino, VALOR_VARIAVEL, 0);
+    }
+}
+
+/* Primeira visita a um bloco executável: phis, operações e, se ele não
+   termina num cbr, todas as arestas de saída */
+static void visitar_bloco(SCCP *s, int b) {
+    BlocoBasico *bl = &s->cfg->blocos[b];
+    for (int p = s->ssa->inicio_phis[b]; p < s->ssa->inicio_phis[b + 1]; p++) avaliar_phi(s, &s->ssa->phis[p]);
+    for (int i = bl->inicio; i <= bl->fim; i++) avaliar_operacao(s, i);
+    if (s->f->ops[bl->fim].opcode != OP_CBR) {
+        for (int k = 0; k < bl->num_sucessores; k++) marcar_aresta(s, b, k);
+    }
+}
+
+/* Estado inicial de cada temporário e leitores de cada um (CSR) */
+static void montar_usos(SCCP *s) {
+    FuncaoILOC *f = s->f;
+    FormaSSA *ssa = s->ssa;
+    s->faixa = faixa_temporarios(f);
+
+    // Temporário sem definição na função começa como variável
+    s->nivel = (int*)malloc((s->faixa + 1) * sizeof(int));
+    s->valor = (int*)calloc(s->faixa + 1, sizeof(int));
+    for (int t = 0; t < s->faixa; t++) s->nivel[t] = VALOR_VARIAVEL;
+    for (int i = 0; i < f->num_ops; i++) {
+        int id = indice_temp(s, temp_definido(&f->ops[i]));
+        if (id >= 0) s->nivel[id] = VALOR_INDEFINIDO;
+    }
+    for (int p = 0; p < ssa->num_phis; p++) {
+        int id = indice_temp(s, ssa->phis[p].destino);
+        if (id >= 0) s->nivel[id] = VALOR_INDEFINIDO;
+    }
+
+    // Duas passadas: conta e preenche
+    s->inicio_usos = (int*)calloc(s->faixa + 2, sizeof(int));
+    int total = 0;
+    for (int p = 0; p < ssa->num_phis; p++) total += ssa->phis[p].num_argumentos;
+    s->usos = (int*)malloc((total + 2 * f->num_ops + 1) * sizeof(int));
+    int *preenchidos = (int*)calloc(s->faixa + 1, sizeof(int));
+    for (int passada = 0; passada < 2; passada++) {
+        for (int i = 0; i < f->num_ops; i++) {
+            OperacaoILOC *op = &f->ops[i];
+            for (int k = 0; k < op->num_fonte + (op->opcode == OP_STORE); k++) {
+                OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+                int id = (o->tipo == OPERAND_REGISTER) ? indice_temp(s, o->valor.reg) : -1;
+                if (id < 0) continue;
+                if (passada == 0) s->inicio_usos[id + 1]++;
+                else s->usos[s->inicio_usos[id] + preenchidos[id]++] = i;
+            }
+        }
+        for (int p = 0; p < ssa->num_phis; p++) {
+            for (int a = 0; a < ssa->phis[p].num_argumentos; a++) {
+                int id = indice_temp(s, ssa->phis[p].argumentos[a]);
+                if (id < 0) continue;
+                if (passada == 0) s->inicio_usos[id + 1]++;
+                else s->usos[s->inicio_usos[id] + preenchidos[id]++] = f->num_ops + p;
+            }
+        }
+        if (passada == 0) {
+            for (int t = 0; t < s->faixa; t++) s->inicio_usos[t + 1] += s->inicio_usos[t];
+        }
+    }
+    free(preenchidos);
+}
+
+/* Aplica o resultado da análise. Phis constantes viram loadI no início do
+   bloco (depois do nop do rótulo: toda junção começa num rótulo), o que
+   exige remontar o vetor; os líderes dos blocos não mudam. */
+static int reescrever(SCCP *s) {
+    FuncaoILOC *f = s->f;
+    FormaSSA *ssa = s->ssa;
+    CFG *cfg = s->cfg;
+    int alteradas = 0;
+    int *constantes_bloco = (int*)calloc(cfg->num_blocos + 1, sizeof(int));
+    int num_constantes = 0;
+
+    for (int b = 0; b < cfg->num_blocos; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        int executavel = s->bloco_executavel[b];
+
+        for (int i = bl->inicio; i <= bl->fim; i++) {
+            OperacaoILOC *op = &f->ops[i];
+            int na, va = 0;
+
+            if (!executavel) {
+                // Nunca executado: o desvio final fica (sem ler nada) para não
+                // fundir o bloco com o seguinte, o resto vira nop
+                if (op->opcode == OP_CBR) {
+                    reescrever_jumpI(op, op->operandos_alvo[0].valor.rotulo);
+                } else if (op->opcode == OP_RET) {
+                    op->num_fonte = 0;
+                } else if (op->opcode != OP_NOP && !eh_desvio(op->opcode)) {
+                    anular_operacao(op);
+                    alteradas++;
+                }
+                continue;
+            }
+
+            if (op->opcode == OP_CBR) {
+                ler_operando(s, &op->operandos_fonte[0], &na, &va);
+                if (na == VALOR_CONSTANTE) {
+                    reescrever_jumpI(op, op->operandos_alvo[va ? 0 : 1].valor.rotulo);
+                    alteradas++;
+                }
+                continue;
+            }
+
+            int id = indice_temp(s, temp_definido(op));
+            if (id >= 0 && s->nivel[id] == VALOR_CONSTANTE && op->opcode != OP_LOADI) {
+                reescrever_loadI(op, s->valor[id], id);
+                alteradas++;
+            }
+        }
+
+        for (int p = ssa->inicio_phis[b]; p < ssa->inicio_phis[b + 1]; p++) {
+            Phi *phi = &ssa->phis[p];
+            if (phi->destino == REG_NENHUM) continue;
+            int id = indice_temp(s, phi->destino);
+            if (!executavel) {
+                phi->destino = REG_NENHUM;
+                continue;
+            }
+            if (s->nivel[id] == VALOR_CONSTANTE) {
+                constantes_bloco[b]++;
+                num_constantes++;
+                alteradas++;
+                continue;
+            }
+            // Argumentos de arestas mortas não geram cópias na saída da SSA
+            for (int a = 0; a < phi->num_argumentos; a++) {
+                if (!aresta_executavel(s, phi->predecessores[a], b)) phi->argumentos[a] = REG_NENHUM;
+            }
+        }
+    }
+
+    if (num_constantes > 0) {
+        FuncaoILOC nova = {.nome = f->nome};
+        for (int b = 0; b < cfg->num_blocos; b++) {
+            BlocoBasico *bl = &cfg->blocos[b];
+            anexar_operacao_funcao(&nova, &f->ops[bl->inicio]);
+            for (int p = ssa->inicio_phis[b]; p < ssa->inicio_phis[b + 1] && constantes_bloco[b] > 0; p++) {
+                Phi *phi = &ssa->phis[p];
+                int id = indice_temp(s, phi->destino);
+                if (phi->destino == REG_NENHUM || s->nivel[id] != VALOR_CONSTANTE) continue;
+                anexar_operacao_funcao(&nova, criar_loadI(s->valor[id], phi->destino));
+                phi->destino = REG_NENHUM;
+            }
+            for (int i = bl->inicio + 1; i <= bl->fim; i++) anexar_operacao_funcao(&nova, &f->ops[i]);
+        }
+        free(f->ops);
+        f->ops = nova.ops;
+        f->num_ops = nova.num_ops;
+        f->capacidade = nova.capacidade;
+    }
+
+    free(constantes_bloco);
+    return alteradas;
+}
+
+int propagar_constantes(FuncaoILOC *funcao, FormaSSA *ssa) {
+    if (funcao->num_ops == 0) return 0;
+
+    SCCP s;
+    memset(&s, 0, sizeof(SCCP));
+    s.f = funcao;
+    s.ssa = ssa;
+    s.cfg = ssa->cfg;
+    int n = s.cfg->num_blocos;
+
+    montar_usos(&s);
+    s.bloco_executavel = (char*)calloc(n + 1, sizeof(char));
+    s.aresta_executavel = (char*)calloc(2 * n + 1, sizeof(char));
+    s.lista_arestas = (int*)malloc((2 * n + 1) * sizeof(int));
+    s.lista_temps = (int*)malloc((2 * s.faixa + 1) * sizeof(int));
+
+    s.bloco_executavel[0] = 1;
+    visitar_bloco(&s, 0);
+
+    while (s.num_lista_arestas > 0 || s.num_lista_temps > 0) {
+        while (s.num_lista_arestas > 0) {
+            int a = s.lista_arestas[--s.num_lista_arestas];
+            int destino = s.cfg->blocos[a / 2].sucessores[a % 2];
+            if (!s.bloco_executavel[destino]) {
+                s.bloco_executavel[destino] = 1;
+                visitar_bloco(&s, destino);
+            } else {
+                for (int p = ssa->inicio_phis[destino]; p < ssa->inicio_phis[destino + 1]; p++) {
+                    avaliar_phi(&s, &ssa->phis[p]);
+                }
+            }
+        }
+        while (s.num_lista_temps > 0) {
+            int t = s.lista_temps[--s.num_lista_temps];
+            for (int u = s.inicio_usos[t]; u < s.inicio_usos[t + 1]; u++) {
+                int leitor = s.usos[u];
+                if (leitor < funcao->num_ops) {
+                    if (s.bloco_executavel[s.cfg->bloco_da_op[leitor]]) avaliar_operacao(&s, leitor);
+                } else {
+                    Phi *phi = &ssa->phis[leitor - funcao->num_ops];
+                    if (s.bloco_executavel[phi->bloco]) avaliar_phi(&s, phi);
+                }
+            }
+        }
+    }
+
+    int alteradas = reescrever(&s);
+    if (alteradas > 0) atualizar_ssa(funcao, ssa);
+
+    free(s.lista_temps);
+    free(s.lista_arestas);
+    free(s.aresta_executavel);
+    free(s.bloco_executavel);
+    free(s.usos);
+    free(s.inicio_usos);
+    free(s.valor);
+    free(s.nivel);
+    return alteradas;
+}
+
+/* ================================================================= */
+/* ============= NUMERAÇÃO LOCAL DE VALORES (LVN) ================== */
+/* ================================================================= */
+
+/* Operando de uma expressão na forma canônica: constantes (imediatos e
+   temporários definidos por loadI) comparadas pelo valor, temporários pelo
+   representante do valor que guardam */
+typedef struct operando_valor {
+    int constante;
+    int valor;
+} OperandoValor;
+
+/* Chave da tabela hash. Cargas usam o opcode loadAI com base e offset;
+   por serem só ints, a chave é comparada byte a byte pelo uthash */
+typedef struct chave_valor {
+    int opcode;
+    OperandoValor a, b;
+} ChaveValor;
+
+typedef struct entrada_valor {
+    ChaveValor chave;
+    int temp;               // Temporário que já guarda o valor
+    UT_hash_handle hh;
+} EntradaValor;
+
+typedef struct lvn {
+    int faixa;                  // Temporários [0, faixa)
+    int *substituto;            // Por temporário: quem passa a ser lido no lugar dele
+    int *num_defs;
+    char *eh_constante;
+    int *constante;
+    EntradaValor *expressoes;   // Valores calculados no bloco (ou nos dominadores, na GVN)
+    EntradaValor *memoria;      // Conteúdo conhecido de cada endereço (base, offset)
+    EntradaValor **registro;    // GVN: expressões inseridas, desfeitas ao sair do bloco
+    int num_registro;
+} LVN;
+
+static int indice_lvn(LVN *l, int reg) {
+    return (reg >= 0 && reg < l->faixa) ? reg : -1;
+}
+
+/* Só temporários de definição única carregam um valor fixo */
+static int definicao_unica(LVN *l, int reg) {
+    int id = indice_lvn(l, reg);
+    return id >= 0 && l->num_defs[id] <= 1;
+}
+
+/* Representante do valor do temporário (substituições podem se encadear
+   quando uma phi removida aponta para um valor reaproveitado depois) */
+static int representante(LVN *l, int reg) {
+    int id = indice_lvn(l, reg);
+    while (id >= 0 && l->substituto[id] != REG_NENHUM) {
+        reg = l->substituto[id];
+        id = indice_lvn(l, reg);
+    }
+    return reg;
+}
+
+static void substituir_lidos(LVN *l, OperacaoILOC *op) {
+    for (int k = 0; k < op->num_fonte + (op->opcode == OP_STORE); k++) {
+        OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+        if (o->tipo == OPERAND_REGISTER) o->valor.reg = representante(l, o->valor.reg);
+    }
+}
+
+static int operando_valor(LVN *l, OperandoILOC *o, OperandoValor *ov) {
+    if (o->tipo == OPERAND_IMMEDIATE) {
+        ov->constante = 1;
+        ov->valor = o->valor.imediato;
+        return 1;
+    }
+    if (o->tipo != OPERAND_REGISTER || !definicao_unica(l, o->valor.reg)) return 0;
+    int id = indice_lvn(l, o->valor.reg);
+    ov->constante = l->eh_constante[id];
+    ov->valor = l->eh_constante[id] ? l->constante[id] : o->valor.reg;
+    return 1;
+}
+
+static int comutativa(Opcode op) {
+    return op == OP_ADD || op == OP_MULT || op == OP_AND || op == OP_OR || op == OP_XOR ||
+           op == OP_CMP_EQ || op == OP_CMP_NE;
+}
+
+static EntradaValor* buscar_valor(EntradaValor *tabela, ChaveValor *chave) {
+    EntradaValor *e = NULL;
+    HASH_FIND(hh, tabela, chave, sizeof(ChaveValor), e);
+    return e;
+}
+
+static EntradaValor* registrar_valor(EntradaValor **tabela, ChaveValor *chave, int temp) {
+    EntradaValor *e = buscar_valor(*tabela, chave);
+    if (!e) {
+        e = (EntradaValor*)calloc(1, sizeof(EntradaValor));
+        e->chave = *chave;
+        HASH_ADD(hh, *tabela, chave, sizeof(ChaveValor), e);
+    }
+    e->temp = temp;
+    return e;
+}
+
+static void esquecer_valor(EntradaValor **tabela, ChaveValor *chave) {
+    EntradaValor *e = buscar_valor(*tabela, chave);
+    if (!e) return;
+    HASH_DEL(*tabela, e);
+    free(e);
+}
+
+static void limpar_valores(EntradaValor **tabela) {
+    EntradaValor *e, *tmp;
+    HASH_ITER(hh, *tabela, e, tmp) {
+        HASH_DEL(*tabela, e);
+        free(e);
+    }
+}
+
+/* Chave do endereço base + offset (só rfp e rbss: endereços fixos e que
+   não se sobrepõem, pois cada variável tem seu próprio deslocamento) */
+static int chave_memoria(int base, int offset, ChaveValor *chave) {
+    if (base != REG_RFP && base != REG_RBSS) return 0;
+    memset(chave, 0, sizeof(ChaveValor));
+    chave->opcode = OP_LOADAI;
+    chave->a.valor = base;
+    chave->b.constante = 1;
+    chave->b.valor = offset;
+    return 1;
+}
+
+/* O valor de destino já existe em 'temp': a operação some e quem lia o
+   destino passa a ler temp */
+static int reaproveitar(LVN *l, OperacaoILOC *op, int destino, int temp) {
+    if (!definicao_unica(l, destino) || temp == destino) return 0;
+    l->substituto[indice_lvn(l, destino)] = temp;
+    anular_operacao(op);
+    return 1;
+}
+
+static int numerar_operacao(LVN *l, OperacaoILOC *op) {
+    ChaveValor chave;
+    int destino = temp_definido(op);
+
+    switch (op->opcode) {
+        case OP_LOADI:
+            if (definicao_unica(l, destino)) {
+                l->eh_constante[indice_lvn(l, destino)] = 1;
+                l->constante[indice_lvn(l, destino)] = op->operandos_fonte[0].valor.imediato;
+            }
+            return 0;
+
+        case OP_LOADAI: {
+            if (destino == REG_NENHUM ||
+                !chave_memoria(op->operandos_fonte[0].valor.reg, op->operandos_fonte[1].valor.imediato, &chave)) return 0;
+            EntradaValor *e = buscar_valor(l->memoria, &chave);
+            if (e && reaproveitar(l, op, destino, e->temp)) return 1;
+            if (definicao_unica(l, destino)) registrar_valor(&l->memoria, &chave, destino);
+            return 0;
+        }
+
+        case OP_STOREAI: {
+            // O endereço passa a conter o valor guardado (o próximo loadAI o reaproveita)
+            if (!chave_memoria(op->operandos_alvo[0].valor.reg, op->operandos_alvo[1].valor.imediato, &chave)) {
+                limpar_valores(&l->memoria);
+                return 0;
+            }
+            int valor = op->operandos_fonte[0].valor.reg;
+            if (op->operandos_fonte[0].tipo == OPERAND_REGISTER && definicao_unica(l, valor)) {
+                registrar_valor(&l->memoria, &chave, valor);
+            } else {
+                esquecer_valor(&l->memoria, &chave);
+            }
+            return 0;
+        }
+
+        case OP_STORE:
+            limpar_valores(&l->memoria);
+            return 0;
+
+        case OP_ADD: case OP_SUB: case OP_MULT: case OP_DIV: case OP_RSUBI:
+        case OP_ADDI: case OP_SUBI: case OP_MULTI: case OP_DIVI:
+        case OP_LSHIFTI: case OP_RSHIFTI:
+        case OP_AND: case OP_OR: case OP_XOR:
+        case OP_ANDI: case OP_ORI: case OP_XORI:
+        case OP_CMP_LT: case OP_CMP_LE: case OP_CMP_EQ:
+        case OP_CMP_GE: case OP_CMP_GT: case OP_CMP_NE: {
+            if (destino == REG_NENHUM || op->num_fonte != 2) return 0;
+            // addI r, c e add r, rc (rc = loadI c) têm a mesma chave
+            memset(&chave, 0, sizeof(ChaveValor));
+            chave.opcode = opcode_registrador(op->opcode);
+            if (!operando_valor(l, &op->operandos_fonte[0], &chave.a) ||
+                !operando_valor(l, &op->operandos_fonte[1], &chave.b)) return 0;
+
+            // Operandos de operações comutativas em ordem fixa: a*b e b*a coincidem
+            if (comutativa(chave.opcode) &&
+                (chave.a.constante > chave.b.constante ||
+                 (chave.a.constante == chave.b.constante && chave.a.valor > chave.b.valor))) {
+                OperandoValor t = chave.a;
+                chave.a = chave.b;
+                chave.b = t;
+            }
+
+            EntradaValor *e = buscar_valor(l->expressoes, &chave);
+            if (e) return reaproveitar(l, op, destino, e->temp);
+            if (definicao_unica(l, destino)) {
+                e = registrar_valor(&l->expressoes, &chave, destino);
+                if (l->registro) l->registro[l->num_registro++] = e;
+            }
+            return 0;
+        }
+
+        default:
+            return 0;
+    }
+}
+
+/* Prepara a numeração para os temporários da função (e das phis, se em SSA) */
+static void iniciar_lvn(LVN *l, FuncaoILOC *funcao, FormaSSA *ssa) {
+    memset(l, 0, sizeof(LVN));
+    l->faixa = faixa_temporarios(funcao);
+    l->substituto = (int*)malloc((l->faixa + 1) * sizeof(int));
+    l->num_defs = (int*)calloc(l->faixa + 1, sizeof(int));
+    l->eh_constante = (char*)calloc(l->faixa + 1, sizeof(char));
+    l->constante = (int*)calloc(l->faixa + 1, sizeof(int));
+    for (int t = 0; t < l->faixa; t++) l->substituto[t] = REG_NENHUM;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        int id = indice_lvn(l, temp_definido(&funcao->ops[i]));
+        if (id >= 0) l->num_defs[id]++;
+    }
+    for (int p = 0; ssa && p < ssa->num_phis; p++) {
+        int id = indice_lvn(l, ssa->phis[p].destino);
+        if (id >= 0) l->num_defs[id]++;
+    }
+}
+
+static void liberar_lvn(LVN *l) {
+    limpar_valores(&l->expressoes);
+    limpar_valores(&l->memoria);
+    free(l->registro);
+    free(l->constante);
+    free(l->eh_constante);
+    free(l->num_defs);
+    free(l->substituto);
+}
+
+int numerar_valores_locais(FuncaoILOC *funcao) {
+    LVN l;
+    iniciar_lvn(&l, funcao, NULL);
+
+    // Tabelas zeradas a cada líder de bloco (rótulo ou operação após desvio)
+    int removidas = 0;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        if (i > 0 && (tem_rotulo(op) || eh_desvio(funcao->ops[i - 1].opcode))) {
+            limpar_valores(&l.expressoes);
+            limpar_valores(&l.memoria);
+        }
+        substituir_lidos(&l, op);
+        removidas += numerar_operacao(&l, op);
+    }
+
+    if (removidas > 0) compactar_funcao(funcao);
+
+    liberar_lvn(&l);
+    return removidas;
+}
+
+/* ================================================================= */
+/* ============ NUMERAÇÃO GLOBAL DE VALORES (GVN) ================== */
+/* ================================================================= */
+
+/* Phi sem sentido: todos os argumentos (fora ela mesma e os indefinidos)
+   têm o mesmo representante, que então já domina o bloco */
+static int simplificar_phi(LVN *l, Phi *phi) {
+    if (phi->destino == REG_NENHUM) return 0;
+    int unico = REG_NENHUM;
+    for (int a = 0; a < phi->num_argumentos; a++) {
+        if (phi->argumentos[a] == REG_NENHUM) continue;
+        int r = representante(l, phi->argumentos[a]);
+        if (r == phi->destino || r == unico) continue;
+        if (unico != REG_NENHUM) return 0;
+        unico = r;
+    }
+    if (unico == REG_NENHUM || indice_lvn(l, phi->destino) < 0) return 0;
+    l->substituto[indice_lvn(l, phi->destino)] = unico;
+    phi->destino = REG_NENHUM;
+    return 1;
+}
+
+int eliminar_redundancias(FuncaoILOC *funcao, FormaSSA *ssa) {
+    CFG *cfg = ssa->cfg;
+    Dominancia *dom = ssa->dom;
+    int n = cfg->num_blocos;
+    if (n == 0) return 0;
+
+    LVN l;
+    iniciar_lvn(&l, funcao, ssa);
+    l.registro = (EntradaValor**)malloc((funcao->num_ops + 1) * sizeof(EntradaValor*));
+
+    // Pré-ordem na árvore de dominadores: as expressões de um bloco valem
+    // para os blocos que ele domina e saem da tabela ao voltar dele
+    int *pilha = (int*)malloc((n + 1) * sizeof(int));
+    int *marca = (int*)malloc((n + 1) * sizeof(int));
+    int *proximo_filho = (int*)malloc((n + 1) * sizeof(int));
+    int topo = 0, entrando = 1, eliminadas = 0;
+    pilha[topo++] = 0;
+
+    while (topo > 0) {
+        int b = pilha[topo - 1];
+        if (entrando) {
+            BlocoBasico *bl = &cfg->blocos[b];
+            marca[b] = l.num_registro;
+            proximo_filho[b] = dom->inicio_filhos[b];
+
+            for (int p = ssa->inicio_phis[b]; p < ssa->inicio_phis[b + 1]; p++) {
+                eliminadas += simplificar_phi(&l, &ssa->phis[p]);
+            }
+
+            // Cargas só são reaproveitadas dentro do bloco (stores em outros caminhos)
+            limpar_valores(&l.memoria);
+            for (int i = bl->inicio; i <= bl->fim; i++) {
+                substituir_lidos(&l, &funcao->ops[i]);
+                eliminadas += numerar_operacao(&l, &funcao->ops[i]);
+            }
+        }
+
+        if (proximo_filho[b] < dom->inicio_filhos[b + 1]) {
+            pilha[topo++] = dom->filhos[proximo_filho[b]++];
+            entrando = 1;
+        } else {
+            while (l.num_registro > marca[b]) {
+                EntradaValor *e = l.registro[--l.num_registro];
+                HASH_DEL(l.expressoes, e);
+                free(e);
+            }
+            topo--;
+            entrando = 0;
+        }
+    }
+
+    // Leitores ainda não visitados: argumentos de phis e blocos inalcançáveis
+    if (eliminadas > 0) {
+        for (int i = 0; i < funcao->num_ops; i++) substituir_lidos(&l, &funcao->ops[i]);
+        for (int p = 0; p < ssa->num_phis; p++) {
+            Phi *phi = &ssa->phis[p];
+            for (int a = 0; a < phi->num_argumentos; a++) {
+                if (phi->argumentos[a] != REG_NENHUM) phi->argumentos[a] = representante(&l, phi->argumentos[a]);
+            }
+        }
+    }
+
+    free(proximo_filho);
+    free(marca);
+    free(pilha);
+    liberar_lvn(&l);
+    return eliminadas;
+}
+
+/* ================================================================= */
+/* ================= PROPAGAÇÃO DE CÓPIAS ========================== */
+/* ================================================================= */
+
+/* Esquece as cópias locais que envolvem o temporário redefinido */
+static void matar_copias(int *copia, int *ativas, int *num_ativas, LVN *l, int reg) {
+    int k = 0;
+    for (int j = 0; j < *num_ativas; j++) {
+        int id = ativas[j];
+        if (id == indice_lvn(l, reg) || copia[id] == reg) {
+            copia[id] = REG_NENHUM;
+        } else {
+            ativas[k++] = id;
+        }
+    }
+    *num_ativas = k;
+}
+
+int propagar_copias(FuncaoILOC *funcao) {
+    LVN l;
+    iniciar_lvn(&l, funcao, NULL);
+
+    // Cópias entre temporários de definição única valem na função toda
+    int removidas = 0;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        if (op->opcode != OP_I2I || op->operandos_fonte[0].tipo != OPERAND_REGISTER) continue;
+        int origem = op->operandos_fonte[0].valor.reg, destino = temp_definido(op);
+        if (destino == REG_NENHUM || !definicao_unica(&l, destino) || !definicao_unica(&l, origem)) continue;
+        if (origem != destino) l.substituto[indice_lvn(&l, destino)] = origem;
+        anular_operacao(op);
+        removidas++;
+    }
+
+    // As demais (destinos de phis destruídas) só até o fim do bloco ou até
+    // a origem ou o destino serem redefinidos
+    int *copia = (int*)malloc((l.faixa + 1) * sizeof(int));
+    int *ativas = (int*)malloc((l.faixa + 1) * sizeof(int));
+    int num_ativas = 0;
+    for (int t = 0; t < l.faixa; t++) copia[t] = REG_NENHUM;
+
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        if (i > 0 && (tem_rotulo(op) || eh_desvio(funcao->ops[i - 1].opcode))) {
+            while (num_ativas > 0) copia[ativas[--num_ativas]] = REG_NENHUM;
+        }
+
+        substituir_lidos(&l, op);
+        for (int k = 0; k < op->num_fonte + (op->opcode == OP_STORE); k++) {
+            OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+            int id = (o->tipo == OPERAND_REGISTER) ? indice_lvn(&l, o->valor.reg) : -1;
+            if (id >= 0 && copia[id] != REG_NENHUM) o->valor.reg = copia[id];
+        }
+
+        int destino = temp_definido(op);
+        if (destino == REG_NENHUM) continue;
+        matar_copias(copia, ativas, &num_ativas, &l, destino);
+        if (op->opcode != OP_I2I || op->operandos_fonte[0].tipo != OPERAND_REGISTER) continue;
+        int origem = op->operandos_fonte[0].valor.reg, id = indice_lvn(&l, destino);
+        if (id >= 0 && origem != destino) {
+            copia[id] = origem;
+            ativas[num_ativas++] = id;
+        }
+    }
+
+    // Cópias que ficaram sem leitores somem
+    int *leituras = (int*)calloc(l.faixa + 1, sizeof(int));
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        for (int k = 0; k < op->num_fonte + (op->opcode == OP_STORE); k++) {
+            OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+            int id = (o->tipo == OPERAND_REGISTER) ? indice_lvn(&l, o->valor.reg) : -1;
+            if (id >= 0) leituras[id]++;
+        }
+    }
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        if (op->opcode != OP_I2I) continue;
+        int destino = temp_definido(op);
+        if (destino == REG_NENHUM || leituras[indice_lvn(&l, destino)] > 0) continue;
+        anular_operacao(op);
+        removidas++;
+    }
+
+    if (removidas > 0) compactar_funcao(funcao);
+
+    free(leituras);
+    free(ativas);
+    free(copia);
+    liberar_lvn(&l);
+    return removidas;
+}
+
+/* ================================================================= */
+/* ================== SELEÇÃO DE IMEDIATOS ========================= */
+/* ================================================================= */
+
+/* Constante do operando, se ele é um temporário de definição única por loadI */
+static int operando_constante(OperandoILOC *o, int faixa, int *estado, int *valor, int *c) {
+    if (o->tipo != OPERAND_REGISTER) return 0;
+    int id = o->valor.reg;
+    if (id < 0 || id >= faixa || estado[id] != 1) return 0;
+    *c = valor[id];
+    return 1;
+}
+
+static void reescrever_imediata(OperacaoILOC *op, Opcode opcode, OperandoILOC reg, int imediato) {
+    op->opcode = opcode;
+    op->operandos_fonte[0] = reg;
+    op->operandos_fonte[1] = criar_operando_imediato(imediato);
+    op->num_fonte = 2;
+}
+
+int selecionar_imediatos(FuncaoILOC *funcao) {
+    int faixa = faixa_temporarios(funcao);
+    if (faixa == 0) return 0;
+
+    // estado: 0 sem definição, 1 definido só por um loadI, 2 qualquer outro caso
+    int *estado = (int*)calloc(faixa, sizeof(int));
+    int *valor = (int*)malloc(faixa * sizeof(int));
+    int *leituras = (int*)calloc(faixa, sizeof(int));
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        int d = temp_definido(op);
+        if (d == REG_NENHUM) continue;
+        if (estado[d] == 0 && op->opcode == OP_LOADI) {
+            estado[d] = 1;
+            valor[d] = op->operandos_fonte[0].valor.imediato;
+        } else {
+            estado[d] = 2;
+        }
+    }
+
+    int alteradas = 0;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        Opcode imediata = opcode_imediato(op->opcode);
+        if (imediata != OP_NOP && op->num_fonte == 2) {
+            int ca, cb;
+            int tem_a = operando_constante(&op->operandos_fonte[0], faixa, estado, valor, &ca);
+            int tem_b = operando_constante(&op->operandos_fonte[1], faixa, estado, valor, &cb);
+
+            // Divisão por zero fica como está: o erro acontece na execução
+            if (tem_b && !(op->opcode == OP_DIV && cb == 0)) {
+                reescrever_imediata(op, imediata, op->operandos_fonte[0], cb);
+                alteradas++;
+            } else if (tem_a && comutativa(op->opcode)) {
+                reescrever_imediata(op, imediata, op->operandos_fonte[1], ca);
+                alteradas++;
+            } else if (tem_a && op->opcode == OP_SUB) {
+                reescrever_imediata(op, OP_RSUBI, op->operandos_fonte[1], ca);  // c - x
+                alteradas++;
+            }
+
+            // x * 2^k vira deslocamento (a divisão não: o arredondamento com sinal difere)
+            int c = (op->opcode == OP_MULTI) ? op->operandos_fonte[1].valor.imediato : 0;
+            if (c >= 2 && (c & (c - 1)) == 0) {
+                op->opcode = OP_LSHIFTI;
+                op->operandos_fonte[1].valor.imediato = __builtin_ctz(c);
+            }
+        }
+
+        for (int k = 0; k < op->num_fonte + (op->opcode == OP_STORE); k++) {
+            OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+            int id = (o->tipo == OPERAND_REGISTER) ? o->valor.reg : -1;
+            if (id >= 0 && id < faixa) leituras[id]++;
+        }
+    }
+
+    // loadIs que ficaram sem leitores somem
+    if (alteradas > 0) {
+        for (int i = 0; i < funcao->num_ops; i++) {
+            OperacaoILOC *op = &funcao->ops[i];
+            int d = temp_definido(op);
+            if (op->opcode == OP_LOADI && d != REG_NENHUM && estado[d] == 1 && leituras[d] == 0) {
+                anular_operacao(op);
+            }
+        }
+        compactar_funcao(funcao);
+    }
+
+    free(leituras);
+    free(valor);
+    free(estado);
+    return alteradas;
+}
+
+/* ================================================================= */
+/* ============== ELIMINAÇÃO DE CÓDIGO MORTO ======================= */
+/* ================================================================= */
+
+/* Operações que ficam mesmo sem leitores: escritas na memória, desvios e o retorno */
+static int critica(OperacaoILOC *op) {
+    return op->opcode == OP_STORE || op->opcode == OP_STOREAI || eh_desvio(op->opcode);
+}
+
+int eliminar_codigo_morto(FuncaoILOC *funcao) {
+    int n = funcao->num_ops;
+    int faixa = faixa_temporarios(funcao);
+    if (faixa == 0) return 0;
+
+    // Temporário definido por operação e as definições de cada um
+    int *var_definida = (int*)malloc((n + 1) * sizeof(int));
+    int *inicio_defs = (int*)calloc(faixa + 2, sizeof(int));
+    int *defs = (int*)malloc((n + 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        int d = temp_definido(&funcao->ops[i]);
+        var_definida[i] = (d == REG_NENHUM) ? -1 : d;
+        if (d != REG_NENHUM) inicio_defs[d + 1]++;
+    }
+    for (int t = 0; t < faixa; t++) inicio_defs[t + 1] += inicio_defs[t];
+    int *preenchidas = (int*)calloc(faixa + 1, sizeof(int));
+    for (int i = 0; i < n; i++) {
+        int t = var_definida[i];
+        if (t >= 0) defs[inicio_defs[t] + preenchidas[t]++] = i;
+    }
+
+    // Cadeias uso-definição: por leitura (até duas por operação), a
+    // definição anterior no mesmo bloco, ou -1 se o valor chega da entrada
+    // dele. Nesse caso a leitura fica ligada a todas as definições do
+    // temporário: fora da SSA só as cópias de phis destruídas têm mais de
+    // uma, e marcar a mais só conserva código
+    CFG *cfg = construir_cfg(funcao);
+    int *def_lida = (int*)malloc((2 * n + 1) * sizeof(int));
+    int *ultima = (int*)malloc((faixa + 1) * sizeof(int));
+    for (int t = 0; t < faixa; t++) ultima[t] = -1;
+    for (int b = 0; b < cfg->num_blocos; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        for (int i = bl->inicio; i <= bl->fim; i++) {
+            OperacaoILOC *op = &funcao->ops[i];
+            for (int k = 0; k < 2; k++) {
+                def_lida[2 * i + k] = -1;
+                if (k >= op->num_fonte + (op->opcode == OP_STORE)) continue;
+                OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+                int t = (o->tipo == OPERAND_REGISTER && o->valor.reg >= 0) ? o->valor.reg : -1;
+                if (t >= 0 && t < faixa) def_lida[2 * i + k] = ultima[t];
+            }
+            if (var_definida[i] >= 0) ultima[var_definida[i]] = i;
+        }
+        for (int i = bl->inicio; i <= bl->fim; i++) {
+            if (var_definida[i] >= 0) ultima[var_definida[i]] = -1;
+        }
+    }
+
+    // Marcação: das operações críticas para trás, pelas definições de cada leitura
+    char *marcada = (char*)calloc(n + 1, sizeof(char));
+    char *temp_marcado = (char*)calloc(faixa + 1, sizeof(char));
+    int *pilha = (int*)malloc((n + 1) * sizeof(int));
+    int topo = 0;
+    for (int i = 0; i < n; i++) {
+        if (critica(&funcao->ops[i])) {
+            marcada[i] = 1;
+            pilha[topo++] = i;
+        }
+    }
+    while (topo > 0) {
+        int i = pilha[--topo];
+        OperacaoILOC *op = &funcao->ops[i];
+        for (int k = 0; k < op->num_fonte + (op->opcode == OP_STORE) && k < 2; k++) {
+            OperandoILOC *o = (k < op->num_fonte) ? &op->operandos_fonte[k] : &op->operandos_alvo[0];
+            int t = (o->tipo == OPERAND_REGISTER && o->valor.reg >= 0) ? o->valor.reg : -1;
+            if (t < 0 || t >= faixa) continue;
+
+            // Cada temporário tem suas definições percorridas uma vez só
+            int local = def_lida[2 * i + k];
+            if (local >= 0) {
+                if (!marcada[local]) {
+                    marcada[local] = 1;
+                    pilha[topo++] = local;
+                }
+                continue;
+            }
+            if (temp_marcado[t]) continue;
+            temp_marcado[t] = 1;
+            for (int d = inicio_defs[t]; d < inicio_defs[t + 1]; d++) {
+                if (marcada[defs[d]]) continue;
+                marcada[defs[d]] = 1;
+                pilha[topo++] = defs[d];
+            }
+        }
+    }
+
+    // Varredura: o que não foi marcado não contribui para nada observável
+    int removidas = 0;
+    for (int i = 0; i < n; i++) {
+        if (marcada[i] || funcao->ops[i].opcode == OP_NOP) continue;
+        anular_operacao(&funcao->ops[i]);
+        removidas++;
+    }
+    if (removidas > 0) compactar_funcao(funcao);
+
+    free(pilha);
+    free(temp_marcado);
+    free(marcada);
+    free(ultima);
+    free(def_lida);
+    liberar_cfg(cfg);
+    free(preenchidas);
+    free(defs);
+    free(inicio_defs);
+    free(var_definida);
+    return removidas;
+}
+
+/* ================================================================= */
+/* ============= ELIMINAÇÃO DE STORES MORTOS (DSE) ================= */
+/* ================================================================= */
+
+/* Posição do endereço base + offset no universo da vivacidade de memória:
+   as locais primeiro, depois as globais. -1 se a base não é rfp nem rbss. */
+static int posicao_memoria(int base, int offset, int num_locais) {
+    if (base == REG_RFP) return offset / 4;
+    if (base == REG_RBSS) return num_locais + offset / 4;
+    return -1;
+}
+
+/* Endereço lido pela operação (-1 se nenhum, -2 se qualquer um) */
+static int memoria_lida(OperacaoILOC *op, int num_locais) {
+    if (op->opcode == OP_LOAD) return -2;
+    if (op->opcode != OP_LOADAI) return -1;
+    int m = posicao_memoria(op->operandos_fonte[0].valor.reg, op->operandos_fonte[1].valor.imediato, num_locais);
+    return (m >= 0) ? m : -2;
+}
+
+/* Endereço que a operação sobrescreve por inteiro (-1 se nenhum conhecido) */
+static int memoria_escrita(OperacaoILOC *op, int num_locais) {
+    if (op->opcode != OP_STOREAI) return -1;
+    return posicao_memoria(op->operandos_alvo[0].valor.reg, op->operandos_alvo[1].valor.imediato, num_locais);
+}
+
+int eliminar_stores_mortos(FuncaoILOC *funcao) {
+    int num_locais = 0, num_globais = 0;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        OperacaoILOC *op = &funcao->ops[i];
+        OperandoILOC *base = NULL, *offset = NULL;
+        if (op->opcode == OP_LOADAI) { base = &op->operandos_fonte[0]; offset = &op->operandos_fonte[1]; }
+        if (op->opcode == OP_STOREAI) { base = &op->operandos_alvo[0]; offset = &op->operandos_alvo[1]; }
+        if (!base) continue;
+        int v = offset->valor.imediato / 4 + 1;
+        if (base->valor.reg == REG_RFP && v > num_locais) num_locais = v;
+        if (base->valor.reg == REG_RBSS && v > num_globais) num_globais = v;
+    }
+    int total = num_locais + num_globais;
+    if (total == 0) return 0;
+
+    // Vivacidade dos endereços, para trás: gen = lido antes de ser escrito
+    // no bloco, kill = escrito. Na saída da função as locais morrem e as
+    // globais continuam vivas (quem chamou pode lê-las).
+    CFG *cfg = construir_cfg(funcao);
+    ProblemaFluxo *p = criar_problema_fluxo(cfg, total, FLUXO_PARA_TRAS, CONFLUENCIA_UNIAO);
+    for (int b = 0; b < cfg->num_blocos; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        uint64_t *gen = CONJUNTO(p, gen, b), *kill = CONJUNTO(p, kill, b);
+        for (int i = bl->inicio; i <= bl->fim; i++) {
+            int lida = memoria_lida(&funcao->ops[i], num_locais);
+            if (lida == -2) {
+                for (int m = 0; m < total; m++) {
+                    if (!BIT_TEST(kill, m)) BIT_SET(gen, m);
+                }
+            } else if (lida >= 0 && !BIT_TEST(kill, lida)) {
+                BIT_SET(gen, lida);
+            }
+            int escrita = memoria_escrita(&funcao->ops[i], num_locais);
+            if (escrita >= 0) BIT_SET(kill, escrita);
+        }
+        if (bl->num_sucessores == 0) {
+            for (int m = num_locais; m < total; m++) {
+                if (!BIT_TEST(kill, m)) BIT_SET(gen, m);
+            }
+        }
+    }
+    resolver_fluxo(p);
+
+    // Cada bloco de trás para frente: um store para um endereço morto
+    // (sobrescrito antes de ser lido, ou local que não é mais lida) some
+    uint64_t *vivos = (uint64_t*)malloc(p->palavras * sizeof(uint64_t));
+    int removidas = 0;
+    for (int b = 0; b < cfg->num_blocos; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        memcpy(vivos, CONJUNTO(p, out, b), p->palavras * sizeof(uint64_t));
+        if (bl->num_sucessores == 0) {
+            for (int m = num_locais; m < total; m++) BIT_SET(vivos, m);
+        }
+        for (int i = bl->fim; i >= bl->inicio; i--) {
+            OperacaoILOC *op = &funcao->ops[i];
+            int escrita = memoria_escrita(op, num_locais);
+            if (escrita >= 0) {
+                if (!BIT_TEST(vivos, escrita)) {
+                    anular_operacao(op);
+                    removidas++;
+                    continue;
+                }
+                BIT_CLR(vivos, escrita);
+            }
+            int lida = memoria_lida(op, num_locais);
+            if (lida == -2) {
+                for (int m = 0; m < total; m++) BIT_SET(vivos, m);
+            } else if (lida >= 0) {
+                BIT_SET(vivos, lida);
+            }
+        }
+    }
+    if (removidas > 0) compactar_funcao(funcao);
+
+    free(vivos);
+    liberar_problema_fluxo(p);
+    liberar_cfg(cfg);
+    return removidas;
+}
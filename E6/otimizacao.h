@@ -0,0 +1,62 @@
+#ifndef _OTIMIZACAO_H_
+#define _OTIMIZACAO_H_
+
+#include "iloc.h"
+#include "ssa.h"
+
+/* ============================================== */
+/* ========== OTIMIZAÇÕES SOBRE A ILOC ========== */
+/* ============================================== */
+
+/* Propagação de constantes condicional esparsa (Wegman e Zadeck) sobre a
+   função em SSA. Só blocos alcançados por arestas executáveis contribuem
+   para as phis; ao final, operações de resultado constante viram loadI,
+   cbr com condição constante vira jumpI e os blocos nunca executados são
+   esvaziados (ficam inalcançáveis e o layout os descarta).
+   Devolve o número de operações reescritas ou removidas. */
+int propagar_constantes(FuncaoILOC *funcao, FormaSSA *ssa);
+
+/* Numeração local de valores: dentro de cada bloco básico, uma expressão
+   já calculada (com os operandos de add, mult, and, or, xor, cmp_EQ e
+   cmp_NE em ordem canônica) ou uma carga de um endereço lido ou escrito
+   sem store no meio reaproveita o temporário que já guarda o valor, e a
+   operação é removida. Só temporários de definição única participam.
+   Devolve o número de operações removidas. */
+int numerar_valores_locais(FuncaoILOC *funcao);
+
+/* Numeração global de valores sobre a SSA, baseada em dominadores
+   (Briggs, Cooper e Simpson): a tabela de expressões da LVN passa a valer
+   de um bloco para todos os que ele domina, e phis cujos argumentos têm
+   todos o mesmo valor somem. Operações redundantes viram nop, no lugar.
+   Devolve o número de operações e phis eliminadas. */
+int eliminar_redundancias(FuncaoILOC *funcao, FormaSSA *ssa);
+
+/* Propagação de cópias fora da SSA: quem lê o destino de um i2i passa a
+   ler a origem. Entre temporários de definição única a troca vale na
+   função toda; nos demais casos (cópias da saída da SSA), até o fim do
+   bloco ou até a origem ou o destino serem redefinidos. Cópias que ficam
+   sem leitores são removidas. Devolve o número de cópias removidas. */
+int propagar_copias(FuncaoILOC *funcao);
+
+/* Seleção de imediatos: um operando que é temporário de definição única
+   por loadI entra na operação como imediato (add rA, rC -> addI rA, c;
+   c - x vira rsubI e x * 2^k, lshiftI). O loadI sem outros leitores some.
+   Devolve o número de operações reescritas. */
+int selecionar_imediatos(FuncaoILOC *funcao);
+
+/* Eliminação de código morto por marcação e varredura: parte das
+   operações críticas (stores, desvios e retorno) e marca, pelas cadeias
+   uso-definição dos temporários, tudo de que elas dependem. O que sobra
+   não tem efeito observável e é removido.
+   Devolve o número de operações removidas. */
+int eliminar_codigo_morto(FuncaoILOC *funcao);
+
+/* Eliminação de stores mortos: vivacidade dos endereços rfp + c e
+   rbss + c, para trás sobre o CFG. Um storeAI cujo endereço é escrito de
+   novo antes de qualquer leitura, ou que guarda uma local que não é mais
+   lida até o retorno, é removido. Globais são tratadas como vivas na
+   saída da função, e um load de endereço desconhecido lê tudo.
+   Devolve o número de stores removidos. */
+int eliminar_stores_mortos(FuncaoILOC *funcao);
+
+#endif // _OTIMIZACAO_H_
@@ -201,7 +201,7 @@ lista_argumentos_ini
 ;
 
 lista_argumentos
-    : expressao                         { $$ = asd_new("arg_list_temp", TIPO_INDEF, $1->num_linha, NULL, NULL); asd_add_child($$, $1, ORD_NORM); } /* Cria um novo nó 'arg_list' temporário */
+    : expressao                         { $$ = asd_new("arg_list_temp", TIPO_INDEF, $1->num_linha, REG_NENHUM, NULL); asd_add_child($$, $1, ORD_NORM); } /* Cria um novo nó 'arg_list' temporário */
     | lista_argumentos ',' expressao    { asd_add_child($1, $3, ORD_NORM); $$ = $1; } /* Adiciona a nova expressão como filha do 'arg_list' existente */
 ;
 
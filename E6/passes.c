@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "passes.h"
+#include "otimizacao.h"
+#include "layout.h"
+
+/* ================================================================= */
+/* ===================== PASSES REGISTRADOS ======================== */
+/* ================================================================= */
+
+static int passo_lvn(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return numerar_valores_locais(funcao);
+}
+
+static int passo_sccp(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return propagar_constantes(funcao, ssa);
+}
+
+static int passo_gvn(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return eliminar_redundancias(funcao, ssa);
+}
+
+static int passo_copias(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return propagar_copias(funcao);
+}
+
+static int passo_imediatos(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return selecionar_imediatos(funcao);
+}
+
+static int passo_dse(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return eliminar_stores_mortos(funcao);
+}
+
+static int passo_dce(FuncaoILOC *funcao, FormaSSA *ssa) {
+    return eliminar_codigo_morto(funcao);
+}
+
+static int passo_layout(FuncaoILOC *funcao, FormaSSA *ssa) {
+    ordenar_blocos(funcao);
+    return 0;
+}
+
+static const Passo tabela_passes[] = {
+    {"lvn",       0, passo_lvn},
+    {"ssa",       1, NULL},
+    {"sccp",      1, passo_sccp},
+    {"gvn",       1, passo_gvn},
+    {"copias",    0, passo_copias},
+    {"imediatos", 0, passo_imediatos},
+    {"dse",       0, passo_dse},
+    {"dce",       0, passo_dce},
+    {"layout",    0, passo_layout},
+};
+
+#define NUM_PASSES ((int)(sizeof(tabela_passes) / sizeof(tabela_passes[0])))
+
+/* Sequências dos níveis -O, pelos nomes */
+static const char *nivel_O1 = "lvn,imediatos,dse,dce,layout";
+static const char *nivel_O2 = "lvn,ssa,sccp,gvn,copias,imediatos,dse,dce,layout";
+
+/* ================================================================= */
+/* ========================== ESTADO =============================== */
+/* ================================================================= */
+
+int medir_passes = 0;
+
+static int sequencia[MAX_SEQUENCIA_PASSES];
+static int tamanho_sequencia = -1;  // -1: ainda não definida (usa -O1)
+
+/* Acumulado por passe; as duas últimas posições são a entrada e a saída da
+   SSA feitas pelo gerenciador para um passe que precisa dela */
+typedef struct estatistica_passo {
+    double segundos;
+    long ops_antes;
+    long ops_depois;
+    long alteradas;
+    int execucoes;
+} EstatisticaPasso;
+
+#define ENTRADA_SSA NUM_PASSES
+#define SAIDA_SSA   (NUM_PASSES + 1)
+
+static EstatisticaPasso estatisticas[NUM_PASSES + 2];
+
+/* ================================================================= */
+/* ==================== FUNÇÕES AUXILIARES ========================= */
+/* ================================================================= */
+
+static double agora() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/* Instruções da função: operações que não são nop */
+static int contar_instrucoes(FuncaoILOC *funcao) {
+    int total = 0;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        if (funcao->ops[i].opcode != OP_NOP) total++;
+    }
+    return total;
+}
+
+static int buscar_passo(const char *nome, size_t tamanho) {
+    for (int p = 0; p < NUM_PASSES; p++) {
+        if (strlen(tabela_passes[p].nome) == tamanho && strncmp(tabela_passes[p].nome, nome, tamanho) == 0) return p;
+    }
+    return -1;
+}
+
+/* ================================================================= */
+/* ====================== CONFIGURAÇÃO ============================= */
+/* ================================================================= */
+
+int definir_sequencia_passes(const char *lista) {
+    int nova[MAX_SEQUENCIA_PASSES];
+    int tamanho = 0;
+    const char *p = lista;
+
+    while (*p) {
+        const char *fim = strchr(p, ',');
+        size_t n = fim ? (size_t)(fim - p) : strlen(p);
+        if (n > 0) {
+            int passo = buscar_passo(p, n);
+            if (passo < 0) {
+                fprintf(stderr, "Passe desconhecido: %.*s\n", (int)n, p);
+                return 0;
+            }
+            if (tamanho == MAX_SEQUENCIA_PASSES) {
+                fprintf(stderr, "Sequência de passes longa demais (máximo %d)\n", MAX_SEQUENCIA_PASSES);
+                return 0;
+            }
+            nova[tamanho++] = passo;
+        }
+        p += n;
+        if (*p == ',') p++;
+    }
+
+    memcpy(sequencia, nova, tamanho * sizeof(int));
+    tamanho_sequencia = tamanho;
+    return 1;
+}
+
+void definir_nivel_otimizacao(int nivel) {
+    if (nivel <= 0) tamanho_sequencia = 0;
+    else definir_sequencia_passes(nivel == 1 ? nivel_O1 : nivel_O2);
+}
+
+/* ================================================================= */
+/* ========================= EXECUÇÃO ============================== */
+/* ================================================================= */
+
+/* Roda uma etapa medindo tempo e instruções na posição e da tabela */
+#define MEDIR(e, funcao, alteradas, chamada)                            \
+    do {                                                                \
+        if (!medir_passes) { alteradas = (chamada); break; }            \
+        EstatisticaPasso *est = &estatisticas[e];                       \
+        est->ops_antes += contar_instrucoes(funcao);                    \
+        double inicio = agora();                                        \
+        alteradas = (chamada);                                          \
+        est->segundos += agora() - inicio;                              \
+        est->ops_depois += contar_instrucoes(funcao);                   \
+        est->alteradas += alteradas;                                    \
+        est->execucoes++;                                               \
+    } while (0)
+
+static int entrar_ssa(FuncaoILOC *funcao, FormaSSA **ssa) {
+    *ssa = construir_ssa(funcao);
+    return 0;
+}
+
+static int sair_ssa(FuncaoILOC *funcao, FormaSSA **ssa) {
+    destruir_ssa(funcao, *ssa);
+    *ssa = NULL;
+    return 0;
+}
+
+void executar_passes(FuncaoILOC *funcao) {
+    if (tamanho_sequencia < 0) definir_nivel_otimizacao(1);
+
+    FormaSSA *ssa = NULL;
+    int alteradas;
+    for (int k = 0; k < tamanho_sequencia; k++) {
+        const Passo *passo = &tabela_passes[sequencia[k]];
+        // O passe ssa é a própria construção: o tempo dela fica na linha dele
+        int entrada = passo->executar ? ENTRADA_SSA : sequencia[k];
+        if (passo->precisa_ssa && !ssa) MEDIR(entrada, funcao, alteradas, entrar_ssa(funcao, &ssa));
+        if (!passo->precisa_ssa && ssa) MEDIR(SAIDA_SSA, funcao, alteradas, sair_ssa(funcao, &ssa));
+        if (passo->executar) MEDIR(sequencia[k], funcao, alteradas, passo->executar(funcao, ssa));
+    }
+    if (ssa) MEDIR(SAIDA_SSA, funcao, alteradas, sair_ssa(funcao, &ssa));
+}
+
+void imprimir_estatisticas_passes() {
+    fprintf(stderr, "%-15s %6s %12s %10s %10s %9s %10s\n",
+            "passe", "vezes", "tempo (ms)", "antes", "depois", "saldo", "alteradas");
+    for (int e = 0; e < NUM_PASSES + 2; e++) {
+        EstatisticaPasso *est = &estatisticas[e];
+        if (est->execucoes == 0) continue;
+        const char *nome = (e == ENTRADA_SSA) ? "(construir ssa)" : (e == SAIDA_SSA) ? "(destruir ssa)" : tabela_passes[e].nome;
+        fprintf(stderr, "%-15s %6d %12.3f %10ld %10ld %+9ld %10ld\n",
+                nome, est->execucoes, est->segundos * 1000.0, est->ops_antes, est->ops_depois,
+                est->ops_depois - est->ops_antes, est->alteradas);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef _PASSES_H_
+#define _PASSES_H_
+
+#include "iloc.h"
+#include "ssa.h"
+
+/* ============================================== */
+/* =========== GERENCIADOR DE PASSES ============ */
+/* ============================================== */
+
+/* Passe registrado: transforma uma função e devolve quantas operações
+   alterou. Os que precisam de SSA recebem a forma SSA da função; os outros
+   recebem NULL. O gerenciador entra e sai da SSA conforme a sequência;
+   um passe sem executar (ssa) só pede a entrada nela. */
+typedef struct passo {
+    const char *nome;       // Nome usado em -passes=
+    int precisa_ssa;
+    int (*executar)(FuncaoILOC *funcao, FormaSSA *ssa);
+} Passo;
+
+/* Tamanho máximo de uma sequência explícita */
+#define MAX_SEQUENCIA_PASSES 64
+
+/* Mede tempo e operações de cada passe (-time-passes) */
+extern int medir_passes;
+
+/* ============================================== */
+/* ========= FUNÇÕES DO GERENCIADOR ============= */
+/* ============================================== */
+
+/* Sequência padrão de cada nível: -O0 (nenhum passe), -O1 e -O2 */
+void definir_nivel_otimizacao(int nivel);
+
+/* Sequência explícita: nomes separados por vírgula (-passes=lvn,ssa,sccp).
+   Devolve 0, sem alterar a sequência, se algum nome não é um passe. */
+int definir_sequencia_passes(const char *lista);
+
+/* Roda a sequência sobre a função, que sai dela fora de SSA */
+void executar_passes(FuncaoILOC *funcao);
+
+/* Imprime em stderr, por passe, o tempo total e as operações antes e
+   depois (somadas sobre todas as funções) */
+void imprimir_estatisticas_passes();
+
+#endif // _PASSES_H_
@@ -0,0 +1,480 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "selecao.h"
+#include "assembly.h"
+
+/* Alocação da função em seleção (consultada pelos padrões) */
+static Alocacao *aloc_sel = NULL;
+
+/* ================================================================= */
+/* ==================== FUNÇÕES AUXILIARES ========================= */
+/* ================================================================= */
+
+static int eh_aritmetica(Opcode op) {
+    Opcode base = opcode_registrador(op);
+    return base == OP_ADD || base == OP_SUB || base == OP_MULT ||
+           base == OP_AND || base == OP_OR || base == OP_XOR ||
+           op == OP_RSUBI || op == OP_LSHIFTI || op == OP_RSHIFTI;
+}
+
+static int eh_comutativa(Opcode op) {
+    return op == OP_ADD || op == OP_MULT || op == OP_AND || op == OP_OR || op == OP_XOR;
+}
+
+static const char* mnemonico(Opcode op) {
+    switch (op) {
+        case OP_ADD:  return "addl";
+        case OP_SUB:  return "subl";
+        case OP_MULT: return "imull";
+        case OP_AND:  return "andl";
+        case OP_OR:   return "orl";
+        case OP_XOR:  return "xorl";
+        case OP_RSHIFTI: return "sarl";
+        default:      return "nop";
+    }
+}
+
+/* Log2 de uma potência de dois (>= 2), ou -1 */
+static int log2_exato(int c) {
+    if (c < 2 || (c & (c - 1)) != 0) return -1;
+    return __builtin_ctz(c);
+}
+
+/* Folha a partir de um operando ILOC, de acordo com a alocação */
+static OperandoSel folha(OperandoILOC op) {
+    OperandoSel o = {FORMA_IMM, -1, 0, NULL};
+    if (op.tipo == OPERAND_IMMEDIATE) {
+        o.valor = op.valor.imediato;
+        return o;
+    }
+    o.vreg = vreg_registrador(aloc_sel, op.valor.reg);
+    if (aloc_sel->rematerializavel[o.vreg]) {
+        o.valor = aloc_sel->valor_constante[o.vreg];
+    } else if (aloc_sel->reg[o.vreg] >= 0) {
+        o.forma = FORMA_REG;
+    } else {
+        o.forma = FORMA_MEM;
+    }
+    return o;
+}
+
+static int eh_reg(OperandoSel *o) { return o->forma == FORMA_REG; }
+static int eh_imm(OperandoSel *o) { return o->forma == FORMA_IMM; }
+static int eh_mem(OperandoSel *o) { return o->forma == FORMA_MEM || o->forma == FORMA_GLOBAL; }
+
+static int dst_reg(NoSel *no) { return aloc_sel->reg[no->dst] >= 0; }
+
+/* O operando está no mesmo lugar que o destino do nó */
+static int no_destino(NoSel *no, OperandoSel *o) {
+    if (o->forma == FORMA_REG) return aloc_sel->reg[o->vreg] == aloc_sel->reg[no->dst];
+    if (o->forma == FORMA_MEM && !dst_reg(no)) {
+        return deslocamento_spill(aloc_sel, o->vreg) == deslocamento_spill(aloc_sel, no->dst);
+    }
+    return 0;
+}
+
+static void imprimir_sel(OperandoSel *o) {
+    switch (o->forma) {
+        case FORMA_IMM:    printf("$%d", o->valor); break;
+        case FORMA_GLOBAL: printf("%s(%%rip)", o->global); break;
+        default:           imprimir_vreg(o->vreg); break;
+    }
+}
+
+static const char* reg64(OperandoSel *o) {
+    return reg_fisicos_64[aloc_sel->reg[o->vreg]];
+}
+
+static void imprimir_dst(NoSel *no) {
+    imprimir_vreg(no->dst);
+}
+
+/* ================================================================= */
+/* ===================== TABELA DE PADRÕES ========================= */
+/* ================================================================= */
+
+/* leal (b,x,k), dst  |  leal c(,x,k), dst  — soma com índice escalado */
+static int casa_lea_escala(NoSel *no) {
+    if (no->op != OP_ADD || !dst_reg(no)) return -1;
+    OperandoSel *e = (no->a.forma == FORMA_ESCALA) ? &no->a : &no->b;
+    OperandoSel *o = (e == &no->a) ? &no->b : &no->a;
+    if (e->forma != FORMA_ESCALA || !(eh_reg(o) || eh_imm(o))) return -1;
+    return 1;
+}
+static void emitir_lea_escala(NoSel *no) {
+    OperandoSel *e = (no->a.forma == FORMA_ESCALA) ? &no->a : &no->b;
+    OperandoSel *o = (e == &no->a) ? &no->b : &no->a;
+    const char *x = reg_fisicos_64[aloc_sel->reg[e->vreg]];
+    if (eh_imm(o)) printf("\tleal\t%d(,%s,%d), ", o->valor, x, e->valor);
+    else printf("\tleal\t(%s,%s,%d), ", reg64(o), x, e->valor);
+    imprimir_dst(no); printf("\n");
+}
+
+/* Operando que sobra de x + 0, x - 0, 0 + x, x | 0 ou x ^ 0, ou NULL */
+static OperandoSel* operando_identidade(NoSel *no) {
+    int neutro_b = eh_imm(&no->b) && no->b.valor == 0;
+    int neutro_a = eh_imm(&no->a) && no->a.valor == 0;
+    if (no->op == OP_ADD || no->op == OP_OR || no->op == OP_XOR) {
+        if (neutro_b) return &no->a;
+        if (neutro_a) return &no->b;
+    }
+    if (no->op == OP_SUB && neutro_b) return &no->a;
+    return NULL;
+}
+
+/* [movl x, dst]  — operação com elemento neutro: só a cópia, se precisar */
+static int casa_identidade(NoSel *no) {
+    OperandoSel *x = operando_identidade(no);
+    if (!x || x->forma == FORMA_ESCALA) return -1;
+    if (no_destino(no, x)) return 0;
+    if (!dst_reg(no) && eh_mem(x)) return -1;
+    return 1;
+}
+static void emitir_identidade(NoSel *no) {
+    OperandoSel *x = operando_identidade(no);
+    if (no_destino(no, x)) return;
+    printf("\tmovl\t"); imprimir_sel(x); printf(", "); imprimir_dst(no); printf("\n");
+}
+
+/* op b, dst  — destino reaproveita o operando da esquerda */
+static int casa_dois_end(NoSel *no) {
+    if (no->a.forma == FORMA_ESCALA || no->b.forma == FORMA_ESCALA) return -1;
+    if (!no_destino(no, &no->a) || no_destino(no, &no->b)) return -1;
+    if (!dst_reg(no)) {
+        // Memória como destino: fonte em registrador/imediato, e imull não aceita
+        if (no->op == OP_MULT || eh_mem(&no->b)) return -1;
+        return 2;
+    }
+    return 1;
+}
+static void emitir_dois_end(NoSel *no) {
+    printf("\t%s\t", mnemonico(no->op)); imprimir_sel(&no->b); printf(", "); imprimir_dst(no); printf("\n");
+}
+
+/* op a, dst  — operação comutativa com o destino no operando da direita */
+static int casa_dois_end_comut(NoSel *no) {
+    if (!eh_comutativa(no->op)) return -1;
+    NoSel trocado = *no;
+    trocado.a = no->b;
+    trocado.b = no->a;
+    return casa_dois_end(&trocado);
+}
+static void emitir_dois_end_comut(NoSel *no) {
+    printf("\t%s\t", mnemonico(no->op)); imprimir_sel(&no->a); printf(", "); imprimir_dst(no); printf("\n");
+}
+
+/* sall $k, dst  — multiplicação por potência de dois no próprio destino */
+static int casa_shl(NoSel *no) {
+    if (no->op != OP_MULT) return -1;
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *o = (c == &no->b) ? &no->a : &no->b;
+    if (!eh_imm(c) || log2_exato(c->valor) < 0 || !no_destino(no, o)) return -1;
+    return dst_reg(no) ? 1 : 2;
+}
+static void emitir_shl(NoSel *no) {
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    printf("\tsall\t$%d, ", log2_exato(c->valor)); imprimir_dst(no); printf("\n");
+}
+
+/* movl x, dst; sall $k, dst  — potência de dois com o fator em outro lugar */
+static int casa_mov_shl(NoSel *no) {
+    if (no->op != OP_MULT || !dst_reg(no)) return -1;
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *x = (c == &no->b) ? &no->a : &no->b;
+    if (!eh_imm(c) || log2_exato(c->valor) < 0 || x->forma == FORMA_ESCALA) return -1;
+    return 2;
+}
+static void emitir_mov_shl(NoSel *no) {
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *x = (c == &no->b) ? &no->a : &no->b;
+    printf("\tmovl\t"); imprimir_sel(x); printf(", "); imprimir_dst(no); printf("\n");
+    printf("\tsall\t$%d, ", log2_exato(c->valor)); imprimir_dst(no); printf("\n");
+}
+
+/* leal 0(,x,k), dst  — multiplicação por 2, 4 ou 8 de um registrador em outro */
+static int casa_lea_mul(NoSel *no) {
+    if (no->op != OP_MULT || !dst_reg(no)) return -1;
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *x = (c == &no->b) ? &no->a : &no->b;
+    if (!eh_imm(c) || !eh_reg(x) || (c->valor != 2 && c->valor != 4 && c->valor != 8)) return -1;
+    return 1;
+}
+static void emitir_lea_mul(NoSel *no) {
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *x = (c == &no->b) ? &no->a : &no->b;
+    printf("\tleal\t0(,%s,%d), ", reg64(x), c->valor); imprimir_dst(no); printf("\n");
+}
+
+/* leal (a,b), dst  — soma de dois registradores em um terceiro */
+static int casa_lea_soma(NoSel *no) {
+    if (no->op != OP_ADD || !dst_reg(no)) return -1;
+    if (!eh_reg(&no->a) || !eh_reg(&no->b)) return -1;
+    return 1;
+}
+static void emitir_lea_soma(NoSel *no) {
+    printf("\tleal\t(%s,%s), ", reg64(&no->a), reg64(&no->b)); imprimir_dst(no); printf("\n");
+}
+
+/* leal c(a), dst  — soma/subtração de constante em outro registrador */
+static int casa_lea_imediato(NoSel *no) {
+    if (!dst_reg(no)) return -1;
+    if (no->op == OP_ADD && ((eh_reg(&no->a) && eh_imm(&no->b)) || (eh_imm(&no->a) && eh_reg(&no->b)))) return 1;
+    if (no->op == OP_SUB && eh_reg(&no->a) && eh_imm(&no->b) && no->b.valor != (int)0x80000000) return 1;
+    return -1;
+}
+static void emitir_lea_imediato(NoSel *no) {
+    OperandoSel *r = eh_reg(&no->a) ? &no->a : &no->b;
+    OperandoSel *c = (r == &no->a) ? &no->b : &no->a;
+    int desloc = (no->op == OP_SUB) ? -c->valor : c->valor;
+    printf("\tleal\t%d(%s), ", desloc, reg64(r)); imprimir_dst(no); printf("\n");
+}
+
+/* leal (x,x,k-1), dst  — multiplicação por 3, 5 ou 9 */
+static int casa_mul_lea(NoSel *no) {
+    if (no->op != OP_MULT || !dst_reg(no)) return -1;
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *x = (c == &no->b) ? &no->a : &no->b;
+    if (!eh_imm(c) || !eh_reg(x)) return -1;
+    if (c->valor != 3 && c->valor != 5 && c->valor != 9) return -1;
+    return 1;
+}
+static void emitir_mul_lea(NoSel *no) {
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *x = (c == &no->b) ? &no->a : &no->b;
+    printf("\tleal\t(%s,%s,%d), ", reg64(x), reg64(x), c->valor - 1); imprimir_dst(no); printf("\n");
+}
+
+/* imull $c, src, dst  — forma de três operandos */
+static int casa_imul3(NoSel *no) {
+    if (no->op != OP_MULT || !dst_reg(no)) return -1;
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *o = (c == &no->b) ? &no->a : &no->b;
+    if (!eh_imm(c) || !(eh_reg(o) || eh_mem(o))) return -1;
+    return 2;
+}
+static void emitir_imul3(NoSel *no) {
+    OperandoSel *c = eh_imm(&no->b) ? &no->b : &no->a;
+    OperandoSel *o = (c == &no->b) ? &no->a : &no->b;
+    printf("\timull\t$%d, ", c->valor); imprimir_sel(o); printf(", "); imprimir_dst(no); printf("\n");
+}
+
+/* [movl b, dst;] negl dst  — 0 - b (o rsubI 0 do menos unário) */
+static int casa_neg(NoSel *no) {
+    if (no->op != OP_SUB || !eh_imm(&no->a) || no->a.valor != 0 || no->b.forma == FORMA_ESCALA) return -1;
+    if (no_destino(no, &no->b)) return 1;
+    if (!dst_reg(no) && eh_mem(&no->b)) return -1;
+    return 2;
+}
+static void emitir_neg(NoSel *no) {
+    if (!no_destino(no, &no->b)) {
+        printf("\tmovl\t"); imprimir_sel(&no->b); printf(", "); imprimir_dst(no); printf("\n");
+    }
+    printf("\tnegl\t"); imprimir_dst(no); printf("\n");
+}
+
+/* negl dst; addl a, dst  — subtração com o destino no subtraendo */
+static int casa_neg_add(NoSel *no) {
+    if (no->op != OP_SUB || !dst_reg(no)) return -1;
+    if (no->a.forma == FORMA_ESCALA || !no_destino(no, &no->b) || no_destino(no, &no->a)) return -1;
+    if (eh_imm(&no->a) && no->a.valor == 0) return -1;  // negl basta (padrão neg)
+    return 2;
+}
+static void emitir_neg_add(NoSel *no) {
+    printf("\tnegl\t"); imprimir_dst(no); printf("\n");
+    printf("\taddl\t"); imprimir_sel(&no->a); printf(", "); imprimir_dst(no); printf("\n");
+}
+
+/* movl a, dst; op b, dst  — destino em registrador livre */
+static int casa_mov_op(NoSel *no) {
+    if (!dst_reg(no)) return -1;
+    if (no->a.forma == FORMA_ESCALA || no->b.forma == FORMA_ESCALA) return -1;
+    if (no_destino(no, &no->b)) return -1;
+    return 2;
+}
+static void emitir_mov_op(NoSel *no) {
+    printf("\tmovl\t"); imprimir_sel(&no->a); printf(", "); imprimir_dst(no); printf("\n");
+    printf("\t%s\t", mnemonico(no->op)); imprimir_sel(&no->b); printf(", "); imprimir_dst(no); printf("\n");
+}
+
+/* movl a, %eax; op b, %eax; movl %eax, dst  — sempre se aplica */
+static int casa_via_eax(NoSel *no) {
+    if (no->a.forma == FORMA_ESCALA || no->b.forma == FORMA_ESCALA) return -1;
+    return 3;
+}
+static void emitir_via_eax(NoSel *no) {
+    printf("\tmovl\t"); imprimir_sel(&no->a); printf(", %%eax\n");
+    printf("\t%s\t", mnemonico(no->op)); imprimir_sel(&no->b); printf(", %%eax\n");
+    printf("\tmovl\t%%eax, "); imprimir_dst(no); printf("\n");
+}
+
+/* Em caso de empate vence o padrão que aparece primeiro */
+static const Padrao padroes[] = {
+    {"identidade",      casa_identidade,      emitir_identidade},
+    {"lea_escala",      casa_lea_escala,      emitir_lea_escala},
+    {"shl",             casa_shl,             emitir_shl},
+    {"dois_end",        casa_dois_end,        emitir_dois_end},
+    {"dois_end_comut",  casa_dois_end_comut,  emitir_dois_end_comut},
+    {"lea_soma",        casa_lea_soma,        emitir_lea_soma},
+    {"lea_imediato",    casa_lea_imediato,    emitir_lea_imediato},
+    {"mul_lea",         casa_mul_lea,         emitir_mul_lea},
+    {"lea_mul",         casa_lea_mul,         emitir_lea_mul},
+    {"mov_shl",         casa_mov_shl,         emitir_mov_shl},
+    {"imul3",           casa_imul3,           emitir_imul3},
+    {"neg",             casa_neg,             emitir_neg},
+    {"neg_add",         casa_neg_add,         emitir_neg_add},
+    {"mov_op",          casa_mov_op,          emitir_mov_op},
+    {"via_eax",         casa_via_eax,         emitir_via_eax},
+};
+#define QTD_PADROES ((int)(sizeof(padroes) / sizeof(padroes[0])))
+
+/* Padrão de menor custo para o nó (custo devolvido em *custo), ou -1 */
+static int melhor_padrao(NoSel *no, int *custo) {
+    int melhor = -1;
+    *custo = INT_MAX;
+    for (int p = 0; p < QTD_PADROES; p++) {
+        int c = padroes[p].casa(no);
+        if (c >= 0 && (melhor < 0 || c < *custo)) {
+            melhor = p;
+            *custo = c;
+        }
+    }
+    return melhor;
+}
+
+/* ================================================================= */
+/* ====================== MONTAGEM DOS NÓS ========================= */
+/* ================================================================= */
+
+/* Operação que não gera código (constante rematerializada ou nop sem rótulo) */
+static int transparente(OperacaoILOC *op) {
+    if (tem_rotulo(op)) return 0;
+    if (op->opcode == OP_NOP) return 1;
+    if (op->opcode == OP_LOADI) {
+        int v = vreg_registrador(aloc_sel, op->operandos_alvo[0].valor.reg);
+        return v >= 0 && aloc_sel->rematerializavel[v];
+    }
+    return 0;
+}
+
+static NoSel montar_no(OperacaoILOC *op) {
+    NoSel no;
+    no.filho = -1;
+    no.dst = vreg_registrador(aloc_sel, op->operandos_alvo[0].valor.reg);
+    if (op->opcode == OP_RSUBI) {
+        // rsubI rA, c => rB  ==  c - rA
+        no.op = OP_SUB;
+        no.a = folha(op->operandos_fonte[1]);
+        no.b = folha(op->operandos_fonte[0]);
+    } else if (op->opcode == OP_LSHIFTI) {
+        // lshiftI rA, k => rB  ==  rA * 2^k (os padrões de mult escolhem shl ou lea)
+        no.op = OP_MULT;
+        no.a = folha(op->operandos_fonte[0]);
+        no.b = folha(op->operandos_fonte[1]);
+        no.b.valor = (int)(1u << (no.b.valor & 31));
+    } else if (op->opcode == OP_RSHIFTI) {
+        // rshiftI rA, k => rB: deslocamento aritmético (sarl $k), sem forma entre registradores
+        no.op = OP_RSHIFTI;
+        no.a = folha(op->operandos_fonte[0]);
+        no.b = folha(op->operandos_fonte[1]);
+    } else {
+        // Formas com imediato (addI, multI...) viram a operação com folha $c
+        no.op = opcode_registrador(op->opcode);
+        no.a = folha(op->operandos_fonte[0]);
+        no.b = folha(op->operandos_fonte[1]);
+    }
+    return no;
+}
+
+/* Tenta cobrir a operação filha c pelo operando o do nó. Cargas de globais
+   viram operandos de memória; multiplicações por 2, 4 ou 8 de um registrador
+   viram índice escalado (só úteis para o lea). */
+static int forma_coberta(OperacaoILOC *c, NoSel *no_c, OperandoSel *o) {
+    if (c->opcode == OP_LOADAI && c->operandos_fonte[0].valor.reg == REG_RBSS &&
+        c->operandos_fonte[1].simbolo) {
+        o->forma = FORMA_GLOBAL;
+        o->global = nome_simbolo(c->operandos_fonte[1].simbolo);
+        return 1;
+    }
+    if (eh_aritmetica(c->opcode) && no_c->op == OP_MULT && no_c->filho < 0) {
+        OperandoSel *k = eh_imm(&no_c->b) ? &no_c->b : &no_c->a;
+        OperandoSel *x = (k == &no_c->b) ? &no_c->a : &no_c->b;
+        if (eh_imm(k) && eh_reg(x) && (k->valor == 2 || k->valor == 4 || k->valor == 8)) {
+            o->forma = FORMA_ESCALA;
+            o->vreg = x->vreg;
+            o->valor = k->valor;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+Selecao* selecionar_instrucoes(FuncaoILOC *funcao, Alocacao *a, int *usos) {
+    aloc_sel = a;
+    int n = funcao->num_ops;
+    Selecao *s = (Selecao*)calloc(1, sizeof(Selecao));
+    s->num_ops = n;
+    s->nos = (NoSel*)calloc(n + 1, sizeof(NoSel));
+    s->padrao = (int*)malloc((n + 1) * sizeof(int));
+    s->coberto = (int*)calloc(n + 1, sizeof(int));
+    int *custo = (int*)calloc(n + 1, sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        s->padrao[i] = -1;
+        OperacaoILOC *op = &funcao->ops[i];
+        if (!eh_aritmetica(op->opcode)) continue;
+
+        NoSel no = montar_no(op);
+        s->padrao[i] = melhor_padrao(&no, &custo[i]);
+        s->nos[i] = no;
+
+        // Filho candidato: a operação anterior que gera código, no mesmo bloco
+        int c = i - 1;
+        while (c >= 0 && transparente(&funcao->ops[c])) c--;
+        if (c < 0 || tem_rotulo(op) || tem_rotulo(&funcao->ops[c]) || s->coberto[c]) continue;
+        OperacaoILOC *filho = &funcao->ops[c];
+        if (filho->num_alvo != 1 || filho->operandos_alvo[0].tipo != OPERAND_REGISTER) continue;
+        int t = vreg_registrador(a, filho->operandos_alvo[0].valor.reg);
+        if (t < 0 || usos[t] != 1) continue;
+
+        // Custo do filho emitido sozinho (cargas de global: movl + movl)
+        int custo_filho = eh_aritmetica(filho->opcode) ? custo[c] : 2;
+
+        OperandoSel *lados[2] = {&no.a, &no.b};
+        for (int k = 0; k < 2; k++) {
+            if (lados[k]->forma == FORMA_IMM || lados[k]->vreg != t) continue;
+            NoSel coberto = no;
+            OperandoSel *o = (k == 0) ? &coberto.a : &coberto.b;
+            if (!forma_coberta(filho, &s->nos[c], o)) continue;
+            coberto.filho = c;
+
+            int custo_coberto;
+            int p = melhor_padrao(&coberto, &custo_coberto);
+            if (p >= 0 && custo_coberto < custo[i] + custo_filho) {
+                s->nos[i] = coberto;
+                s->padrao[i] = p;
+                custo[i] = custo_coberto;
+                s->coberto[c] = 1;
+            }
+            break;
+        }
+    }
+
+    free(custo);
+    return s;
+}
+
+int emitir_selecionada(Selecao *s, int i) {
+    if (i < 0 || i >= s->num_ops || s->padrao[i] < 0) return 0;
+    padroes[s->padrao[i]].emitir(&s->nos[i]);
+    return 1;
+}
+
+void liberar_selecao(Selecao *s) {
+    if (!s) return;
+    free(s->nos);
+    free(s->padrao);
+    free(s->coberto);
+    free(s);
+}
@@ -0,0 +1,65 @@
+#ifndef _SELECAO_H_
+#define _SELECAO_H_
+
+#include "iloc.h"
+#include "alocacao.h"
+
+/* ============================================== */
+/* ========= SELEÇÃO DE INSTRUÇÕES (BURS) ======= */
+/* ============================================== */
+
+/* Forma de um operando já com a alocação aplicada */
+typedef enum {
+    FORMA_REG,          // Registrador físico
+    FORMA_IMM,          // Constante ($c)
+    FORMA_MEM,          // Slot de spill na pilha
+    FORMA_GLOBAL,       // Variável global (nome(%rip)), carga coberta pelo nó
+    FORMA_ESCALA        // vreg * fator (2, 4, 8), multiplicação coberta pelo nó
+} FormaOperando;
+
+typedef struct operando_sel {
+    FormaOperando forma;
+    int vreg;           // REG/MEM: vreg; ESCALA: vreg do índice
+    int valor;          // IMM: constante; ESCALA: fator
+    const char *global; // GLOBAL: nome do símbolo
+} OperandoSel;
+
+/* Nó da árvore de expressão: uma operação aritmética cujos operandos são
+   folhas (vregs, constantes) ou a operação filha que ele cobre */
+typedef struct no_sel {
+    Opcode op;          // rsubI vira OP_SUB com o imediato à esquerda
+    OperandoSel a, b;
+    int dst;            // vreg destino
+    int filho;          // Índice da operação coberta, ou -1
+} NoSel;
+
+/* Padrão da tabela: custo (em instruções) se casa com o nó, ou -1 */
+typedef struct padrao {
+    const char *nome;
+    int (*casa)(NoSel *no);
+    void (*emitir)(NoSel *no);
+} Padrao;
+
+/* Resultado da seleção para uma função */
+typedef struct selecao {
+    int num_ops;
+    NoSel *nos;         // Por operação: o nó montado (se aritmética)
+    int *padrao;        // Por operação: índice na tabela, ou -1
+    int *coberto;       // Por operação: 1 se foi absorvida pelo nó consumidor
+} Selecao;
+
+/* ============================================== */
+/* ============ FUNÇÕES DA SELEÇÃO ============== */
+/* ============================================== */
+
+/* Escolhe, de baixo para cima, o padrão de menor custo de cada operação
+   aritmética da função. usos[v] é o número de leituras de cada vreg. */
+Selecao* selecionar_instrucoes(FuncaoILOC *funcao, Alocacao *a, int *usos);
+
+/* Emite o padrão escolhido para a operação i (1 se ela foi selecionada) */
+int emitir_selecionada(Selecao *s, int i);
+
+/* Libera a seleção */
+void liberar_selecao(Selecao *s);
+
+#endif // _SELECAO_H_
@@ -46,7 +46,7 @@ asd_tree_t* criar_no_folha(ValorLexico* token, TipoDados tipo, NaturezaSimbolo n
 
     // Variaveis necessárias para geração de código
     ListaILOC* lista_codigo = NULL;
-    char* temporario_retorno = NULL;
+    int temporario_retorno = REG_NENHUM;
 
     // Geração de código para literais inteiros
     if(tipo == TIPO_INT && natureza == NAT_LITERAL){
@@ -62,25 +62,92 @@ asd_tree_t* criar_no_folha(ValorLexico* token, TipoDados tipo, NaturezaSimbolo n
 
     asd_tree_t* no = asd_new(token->valor_token, tipo, token->num_linha, temporario_retorno, lista_codigo);
 
-    free(temporario_retorno);
     free_token(token);
     return no;
 }
 
+/* ==================================================================== */
+/* ============ DOBRAMENTO DE CONSTANTES E SIMPLIFICAÇÕES ============= */
+/* ==================================================================== */
+
+/* Expressões não têm efeitos colaterais (chamadas não geram código), então
+   o código de um operando cujo valor não é usado pode ser descartado */
+
+/* Valor do nó quando seu código é um único loadI no seu temporário */
+static int valor_constante(asd_tree_t *no, int *valor) {
+    if (!no || !no->codigo || no->codigo->primeira == OPERACAO_NENHUMA) return 0;
+    if (no->codigo->primeira != no->codigo->ultima) return 0;
+    OperacaoILOC *op = operacao_iloc(no->codigo->primeira);
+    if (op->opcode != OP_LOADI || op->operandos_alvo[0].valor.reg != no->temp) return 0;
+    *valor = op->operandos_fonte[0].valor.imediato;
+    return 1;
+}
+
+/* Troca o valor carregado pelo loadI de um nó constante */
+static void redefinir_constante(asd_tree_t *no, int valor) {
+    operacao_iloc(no->codigo->primeira)->operandos_fonte[0].valor.imediato = valor;
+}
+
+static void descartar_codigo(asd_tree_t *no) {
+    if (no->codigo) liberar_lista_iloc(no->codigo);
+    no->codigo = NULL;
+}
+
+/* Duas subárvores com a mesma forma calculam o mesmo valor: dentro de uma
+   expressão, um mesmo nome é sempre a mesma variável. Nós sem temporário
+   (chamadas) nunca são considerados iguais. */
+static int mesma_expressao(asd_tree_t *a, asd_tree_t *b) {
+    if (a->temp == REG_NENHUM || b->temp == REG_NENHUM) return 0;
+    if (strcmp(a->label, b->label) != 0 || a->number_of_children != b->number_of_children) return 0;
+    for (int i = 0; i < a->number_of_children; i++) {
+        if (!mesma_expressao(a->children[i], b->children[i])) return 0;
+    }
+    return 1;
+}
+
+/* Remove a última operação de uma lista (o rsubI de uma negação) */
+static void remover_ultima_operacao(ListaILOC *lista) {
+    if (lista->primeira == lista->ultima) {
+        lista->primeira = lista->ultima = OPERACAO_NENHUMA;
+        return;
+    }
+    int i = lista->primeira;
+    while (operacao_iloc(i)->proximo != lista->ultima) i = operacao_iloc(i)->proximo;
+    operacao_iloc(i)->proximo = OPERACAO_NENHUMA;
+    lista->ultima = i;
+}
+
+/* Nó de negação (-x) cujo código termina no rsubI que a calcula */
+static int eh_negacao(asd_tree_t *no) {
+    if (strcmp(no->label, "-") != 0 || no->number_of_children != 1 || !no->codigo) return 0;
+    if (no->codigo->ultima == OPERACAO_NENHUMA) return 0;
+    OperacaoILOC *op = operacao_iloc(no->codigo->ultima);
+    return op->opcode == OP_RSUBI && op->operandos_alvo[0].valor.reg == no->temp;
+}
+
 /* Cria um nó de operador unário */
 asd_tree_t* criar_no_unario(const char* op_label, TipoDados tipo, asd_tree_t* filho)
 {
 
     // Variaveis necessárias para geração de código
     ListaILOC* lista_codigo = NULL;
-    char* temporario_retorno = NULL;
+    int temporario_retorno = REG_NENHUM;
+    int valor;
     
+    // Literal negado: o próprio loadI do filho passa a carregar o resultado
+    if ((strcmp(op_label, "-") == 0 || strcmp(op_label, "!") == 0) && valor_constante(filho, &valor)) {
+        redefinir_constante(filho, (op_label[0] == '-') ? (int)(0u - (unsigned int)valor) : (valor == 0));
+        temporario_retorno = filho->temp;
+
+    // Dupla negação: -(-x) é x, sem o rsubI interno
+    }else if(strcmp(op_label, "-") == 0 && eh_negacao(filho)){
+        remover_ultima_operacao(filho->codigo);
+        temporario_retorno = filho->children[0]->temp;
+
     // Operação para indicar número positivo
-    if(strcmp(op_label, "+") == 0){
-        /* O nó pai herda o mesmo nome de temporário do filho */
-        if (filho->temp) {
-            temporario_retorno = strdup(filho->temp);
-        }
+    }else if(strcmp(op_label, "+") == 0){
+        /* O nó pai herda o mesmo temporário do filho */
+        temporario_retorno = filho->temp;
         
     // Operação para trocar sinal de número
     }else if(strcmp(op_label, "-") == 0){
@@ -92,14 +159,13 @@ asd_tree_t* criar_no_unario(const char* op_label, TipoDados tipo, asd_tree_t* fi
     }else if(strcmp(op_label, "!") == 0){
         lista_codigo = criar_lista_iloc();
         temporario_retorno = gerar_temporario();
-        char* temporario_zero = gerar_temporario();
+        int temporario_zero = gerar_temporario();
         adicionar_operacao(lista_codigo, criar_loadI(0, temporario_zero));
         adicionar_operacao(lista_codigo, criar_comparacao(OP_CMP_EQ, temporario_zero, filho->temp, temporario_retorno));
-        free(temporario_zero);
     }
     else {
         // Fallback
-        if (filho->temp) temporario_retorno = strdup(filho->temp);
+        temporario_retorno = filho->temp;
     }
 
     asd_tree_t* no = asd_new(op_label, tipo, filho->num_linha, temporario_retorno, lista_codigo);
@@ -113,7 +179,6 @@ asd_tree_t* criar_no_unario(const char* op_label, TipoDados tipo, asd_tree_t* fi
     // Adiciona o filho na árvore
     asd_add_child(no, filho, ORD_NORM);
 
-    if(temporario_retorno) free(temporario_retorno);
     return no;
 }
 
@@ -123,7 +188,7 @@ asd_tree_t* criar_no_binario(const char* op_label, TipoDados tipo, asd_tree_t* f
 
     // Variaveis necessárias para geração de código
     ListaILOC* lista_codigo = NULL;
-    char* temporario_retorno = NULL;
+    int temporario_retorno = REG_NENHUM;
     
     // Identificar o Opcode baseado na string do operador
     Opcode op = OP_NOP;
@@ -143,8 +208,49 @@ asd_tree_t* criar_no_binario(const char* op_label, TipoDados tipo, asd_tree_t* f
     else if(strcmp(op_label, "&") == 0)  op = OP_AND;
     else if(strcmp(op_label, "|") == 0)  op = OP_OR;
 
+    // Dobramento: literal op literal vira o loadI do primeiro, e identidades
+    // (x+0, x-0, x*1, 1*x, x/1, x&x, x|x) devolvem o operando que sobra
+    int va = 0, vb = 0, resultado;
+    int const_a = valor_constante(filho1, &va);
+    int const_b = valor_constante(filho2, &vb);
+    asd_tree_t *mantido = NULL;     // Filho cujo código e temporário o nó herda
+    int zero = 0;                   // x*0, 0*x e x-x: o resultado é 0
+
+    if (op != OP_NOP && const_a && const_b && avaliar_constante(op, va, vb, &resultado)) {
+        redefinir_constante(filho1, resultado);
+        mantido = filho1;
+    } else if (op == OP_ADD) {
+        if (const_b && vb == 0) mantido = filho1;
+        else if (const_a && va == 0) mantido = filho2;
+    } else if (op == OP_SUB) {
+        if (const_b && vb == 0) mantido = filho1;
+        else if (mesma_expressao(filho1, filho2)) zero = 1;
+    } else if (op == OP_MULT) {
+        if (const_b && vb == 1) mantido = filho1;
+        else if (const_a && va == 1) mantido = filho2;
+        else if (const_b && vb == 0) mantido = filho2;
+        else if (const_a && va == 0) mantido = filho1;
+    } else if (op == OP_DIV) {
+        if (const_b && vb == 1) mantido = filho1;
+    } else if (op == OP_AND || op == OP_OR) {
+        if (mesma_expressao(filho1, filho2)) mantido = filho1;
+    }
+
+    if (mantido) {
+        temporario_retorno = mantido->temp;
+        lista_codigo = mantido->codigo;
+        mantido->codigo = NULL;
+        descartar_codigo(filho1);
+        descartar_codigo(filho2);
+    } else if (zero) {
+        descartar_codigo(filho1);
+        descartar_codigo(filho2);
+        lista_codigo = criar_lista_iloc();
+        temporario_retorno = gerar_temporario();
+        adicionar_operacao(lista_codigo, criar_loadI(0, temporario_retorno));
+
     // Gerar o código se um operador válido foi encontrado
-    if (op != OP_NOP) {
+    } else if (op != OP_NOP) {
         lista_codigo = criar_lista_iloc();
         temporario_retorno = gerar_temporario();
         adicionar_operacao(lista_codigo, criar_aritmetica(op, filho1->temp, filho2->temp, temporario_retorno));
@@ -173,7 +279,6 @@ asd_tree_t* criar_no_binario(const char* op_label, TipoDados tipo, asd_tree_t* f
     asd_add_child(no, filho1, ORD_NORM);
     asd_add_child(no, filho2, ORD_NORM);
 
-    free(temporario_retorno);
     return no;
 }
 
@@ -213,6 +318,9 @@ void semantica_funcao_declaracao(ValorLexico* ident, TipoDados tipo) {
     Simbolo *entrada_fun = create_entry_fun(ident->valor_token, tipo, ident);
     symbol_insert(g_pilha_escopo, ident->valor_token, entrada_fun);
 
+    /* Cada função tem seu próprio frame: locais recomeçam do deslocamento 0 */
+    offset_local = 0;
+
     /* Cria o novo escopo para os parâmetros e corpo */
     semantica_push_scope();
     g_pilha_escopo->tipo_retorno = tipo;
@@ -244,8 +352,8 @@ asd_tree_t* semantica_funcao_definicao(ValorLexico* ident, TipoDados tipo, asd_t
     /* Destrói o escopo da função */
     semantica_pop_scope(); 
 
-    /* Salva o nome da função antes que o token seja liberado */
-    char *nome_funcao = strdup(ident->valor_token);
+    /* Entrada da função na tabela global: o rótulo aponta para ela */
+    Simbolo *funcao = symbol_lookup(g_pilha_escopo, ident->valor_token);
 
     /* Cria o nó da função*/
     asd_tree_t* no = criar_no_folha(ident, tipo, NAT_FUNCAO);
@@ -254,15 +362,12 @@ asd_tree_t* semantica_funcao_definicao(ValorLexico* ident, TipoDados tipo, asd_t
     no->codigo = criar_lista_iloc();
 
     /* Cria e adiciona o rótulo (NOP com label) como a primeira instrução */
-    OperacaoILOC *lbl = criar_nop_com_rotulo(nome_funcao);
+    OperacaoILOC *lbl = criar_inicio_funcao(funcao);
     adicionar_operacao_ini(no->codigo, lbl);
 
     /* Adiciona o corpo como filho. */
     if (corpo) asd_add_child(no, corpo, ORD_NORM);
 
-    /* Libera a string auxiliar */
-    free(nome_funcao);
-
     return no;
 }
 
@@ -300,9 +405,9 @@ asd_tree_t* semantica_comando_atrib(ValorLexico* ident, asd_tree_t* exp) {
     // Operação de store do valor da atribuição
     adicionar_operacao(lista_codigo, criar_storeAI(
         exp->temp,
-        (entrada->is_global == 1) ? "rbss" : "rfp", 
+        (entrada->is_global == 1) ? REG_RBSS : REG_RFP, 
         entrada->deslocamento,
-        (entrada->is_global == 1) ? entrada->chave : NULL // Passa o nome se for global
+        (entrada->is_global == 1) ? entrada : NULL // Passa o símbolo se for global
     ));
     
     // Criação dos nós de atribuição
@@ -327,7 +432,7 @@ asd_tree_t* semantica_chamada_func(ValorLexico* ident, asd_tree_t* lista_arg) {
     /* Cria o nó da chamada de função */
     char* label = malloc(strlen("call ") + strlen(ident->valor_token) + 1); /* label é 'call' seguido do nome da função */
     sprintf(label, "call %s", ident->valor_token);
-    asd_tree_t* no_call = asd_new(label, entrada->tipo_dado, ident->num_linha, NULL, NULL);
+    asd_tree_t* no_call = asd_new(label, entrada->tipo_dado, ident->num_linha, REG_NENHUM, NULL);
     free(label);
 
     /* Verifica se há argumentos e pega a contagem */
@@ -418,19 +523,11 @@ asd_tree_t* semantica_comando_ret(asd_tree_t* exp, TipoDados tipo) {
     // 2. Adiciona a instrução "retorna" na lista
     // Operando fonte: o temporário que contém o resultado da expressão
     // Operando alvo: nenhum (ou pode ser o registrador de retorno da arquitetura, mas aqui abstraimos)
-    OperandoILOC* fonte = criar_operando_registrador(exp->temp);
-    
-    // Cria a operação "retorna" manualmente
-    OperacaoILOC* op_ret = criar_operacao(OP_RET, &fonte, 1, NULL, 0);
-    
-    adicionar_operacao(lista_codigo, op_ret);
-    
-    // Libera a estrutura temporária do operando fonte (o ILOC faz cópia interna)
-    liberar_operando(fonte);
+    adicionar_operacao(lista_codigo, criar_ret(exp->temp));
 
     // 3. Cria o nó na árvore
     // O label é "retorna"
-    asd_tree_t* no = asd_new("retorna", exp->data_type, exp->num_linha, NULL, lista_codigo);
+    asd_tree_t* no = asd_new("retorna", exp->data_type, exp->num_linha, REG_NENHUM, lista_codigo);
     
     // Adiciona a expressão como filha (ordem inversa para calcular a expressão ANTES de retornar)
     asd_add_child(no, exp, ORD_INV);
@@ -443,7 +540,7 @@ asd_tree_t* semantica_condicional(asd_tree_t* exp, asd_tree_t* bloco_if, asd_tre
 
     // Variáveis necessárias para criação de código
     ListaILOC* lista_codigo = criar_lista_iloc();
-    char *rotulo_if, *rotulo_else, *rotulo_fim_else;
+    int rotulo_if, rotulo_else, rotulo_fim_else;
 
     // Geração dos rótulos de salto
     rotulo_if = gerar_rotulo();
@@ -480,7 +577,7 @@ asd_tree_t* semantica_condicional(asd_tree_t* exp, asd_tree_t* bloco_if, asd_tre
     adicionar_operacao(lista_else, criar_nop_com_rotulo(rotulo_fim_else));
     
     // Cria o nó principal 'se'
-    asd_tree_t* no = asd_new("se", exp->data_type, exp->num_linha, NULL, lista_codigo);
+    asd_tree_t* no = asd_new("se", exp->data_type, exp->num_linha, REG_NENHUM, lista_codigo);
     asd_add_child(no, exp, ORD_INV);
 
     // Se não existir bloco if, concatenamos nó com lista artificial
@@ -501,10 +598,6 @@ asd_tree_t* semantica_condicional(asd_tree_t* exp, asd_tree_t* bloco_if, asd_tre
         concatenar_listas(no->codigo, lista_else, ORD_NORM);
     }
 
-    free(rotulo_if);
-    free(rotulo_else);
-    free(rotulo_fim_else);
-
     return no;
 }
 
@@ -512,7 +605,7 @@ asd_tree_t* semantica_enquanto(asd_tree_t* exp, asd_tree_t* bloco){
 
     // Variáveis necessárias para criação de código
     ListaILOC* lista_codigo = criar_lista_iloc();
-    char *rotulo_test, *rotulo_loop, *rotulo_fim_loop;
+    int rotulo_test, rotulo_loop, rotulo_fim_loop;
 
     // Geração dos rótulos de salto
     rotulo_test = gerar_rotulo();
@@ -538,7 +631,7 @@ asd_tree_t* semantica_enquanto(asd_tree_t* exp, asd_tree_t* bloco){
     adicionar_operacao(lista_bloco, criar_nop_com_rotulo(rotulo_fim_loop));
 
     // criação e adição de nós na árvore
-    asd_tree_t* no = asd_new("enquanto", exp->data_type, exp->num_linha, NULL, lista_codigo);
+    asd_tree_t* no = asd_new("enquanto", exp->data_type, exp->num_linha, REG_NENHUM, lista_codigo);
     asd_add_child(no, exp, ORD_INV);
         
     // Se o bloco do enquanto realmente existiu, o adiciona na árvore, senão somente concatena com lista artificial
@@ -548,10 +641,6 @@ asd_tree_t* semantica_enquanto(asd_tree_t* exp, asd_tree_t* bloco){
         concatenar_listas(no->codigo, lista_bloco, ORD_NORM);
     }
 
-    free(rotulo_test);
-    free(rotulo_loop);
-    free(rotulo_fim_loop);
-
     return no;
 }
 
@@ -581,15 +670,15 @@ asd_tree_t* semantica_declaracao_variavel(ValorLexico* ident, TipoDados tipo, as
 
         // Variaveis necessárias para geração de código
         ListaILOC* lista_codigo = criar_lista_iloc();
-        char* temporario_retorno;
+        int temporario_retorno;
         temporario_retorno = gerar_temporario();
 
         // Operação de store do valor com inicialização
         adicionar_operacao(lista_codigo, criar_storeAI(
             atrib->temp,
-            (entrada->is_global == 1) ? "rbss" : "rfp", 
+            (entrada->is_global == 1) ? REG_RBSS : REG_RFP, 
             entrada->deslocamento,
-            (entrada->is_global == 1) ? entrada->chave : NULL
+            (entrada->is_global == 1) ? entrada : NULL
         ));
 
         // Criação e adição de nós na árvore
@@ -599,7 +688,6 @@ asd_tree_t* semantica_declaracao_variavel(ValorLexico* ident, TipoDados tipo, as
         asd_add_child(no, no_identificador, ORD_NORM);
         asd_add_child(no, atrib, ORD_INV);
         
-        free(temporario_retorno);
         return no;
 
     } else {
@@ -621,20 +709,19 @@ asd_tree_t* semantica_identificador_variavel(ValorLexico* ident) {
 
     // Variáveis para tratamento de código
     ListaILOC* lista_codigo = criar_lista_iloc();
-    char* temporario;
+    int temporario;
 
     // loadAI ry(base do escopo local ou global), cz(deslocamento) => rx(temporario)
     temporario = gerar_temporario();
     adicionar_operacao(lista_codigo, criar_loadAI(
-        (entrada->is_global == 1) ? "rbss" : "rfp", 
+        (entrada->is_global == 1) ? REG_RBSS : REG_RFP, 
         entrada->deslocamento,
         temporario,
-        (entrada->is_global == 1) ? entrada->chave : NULL
+        (entrada->is_global == 1) ? entrada : NULL
     ));
 
     asd_tree_t* no = asd_new(ident->valor_token, entrada->tipo_dado, ident->num_linha, temporario, lista_codigo);
 
-    free(temporario);
     free_token(ident);
 
     return no;
@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssa.h"
+
+/* ================================================================= */
+/* ==================== FUNÇÕES AUXILIARES ========================= */
+/* ================================================================= */
+
+/* Variável local acessada por um loadAI/storeAI em rfp, ou -1 */
+static int variavel_acessada(OperacaoILOC *op) {
+    if (op->opcode == OP_LOADAI && op->operandos_fonte[0].valor.reg == REG_RFP) {
+        return op->operandos_fonte[1].valor.imediato / 4;
+    }
+    if (op->opcode == OP_STOREAI && op->operandos_alvo[0].valor.reg == REG_RFP) {
+        return op->operandos_alvo[1].valor.imediato / 4;
+    }
+    return -1;
+}
+
+/* Fronteira de dominância de cada bloco (Cooper, Harvey e Kennedy): a partir
+   de cada predecessor de uma junção, sobe pelos dominadores até o idom dela.
+   Resultado contíguo por bloco em *fronteira, faixas em *inicio. */
+static void fronteiras_dominancia(CFG *cfg, Dominancia *dom, int **fronteira, int **inicio) {
+    int n = cfg->num_blocos;
+    int *contagem = (int*)calloc(n + 2, sizeof(int));
+    int *ultimo = (int*)malloc((n + 1) * sizeof(int));
+
+    // Duas passadas: conta e depois preenche (ultimo[] evita repetições)
+    for (int passada = 0; passada < 2; passada++) {
+        for (int b = 0; b < n; b++) ultimo[b] = -1;
+        for (int b = 0; b < n; b++) {
+            BlocoBasico *bl = &cfg->blocos[b];
+            if (bl->num_predecessores < 2 || dom->idom[b] < 0) continue;
+            for (int k = 0; k < bl->num_predecessores; k++) {
+                int corredor = bl->predecessores[k];
+                if (dom->idom[corredor] < 0) continue;
+                while (corredor != dom->idom[b] && ultimo[corredor] != b) {
+                    ultimo[corredor] = b;
+                    if (passada == 0) contagem[corredor + 1]++;
+                    else (*fronteira)[contagem[corredor]++] = b;
+                    corredor = dom->idom[corredor];
+                }
+            }
+        }
+        if (passada == 0) {
+            for (int b = 0; b < n; b++) contagem[b + 1] += contagem[b];
+            *fronteira = (int*)malloc((contagem[n] + 1) * sizeof(int));
+            *inicio = (int*)malloc((n + 2) * sizeof(int));
+            memcpy(*inicio, contagem, (n + 1) * sizeof(int));
+        }
+    }
+
+    free(ultimo);
+    free(contagem);
+}
+
+/* ================================================================= */
+/* ======================== CONSTRUÇÃO ============================= */
+/* ================================================================= */
+
+/* Variáveis lidas ganham um valor inicial 0 logo após o início da função,
+   para que todo uso tenha uma definição que o domina */
+static int* inserir_valores_iniciais(FuncaoILOC *f, int num_variaveis) {
+    int *inicial = (int*)malloc((num_variaveis + 1) * sizeof(int));
+    for (int v = 0; v < num_variaveis; v++) inicial[v] = REG_NENHUM;
+    for (int i = 0; i < f->num_ops; i++) {
+        int v = variavel_acessada(&f->ops[i]);
+        if (v >= 0 && f->ops[i].opcode == OP_LOADAI) inicial[v] = 0;
+    }
+
+    FuncaoILOC nova = {.nome = f->nome};
+    anexar_operacao_funcao(&nova, &f->ops[0]);
+    for (int v = 0; v < num_variaveis; v++) {
+        if (inicial[v] == REG_NENHUM) continue;
+        inicial[v] = novo_temporario(f);
+        anexar_operacao_funcao(&nova, criar_loadI(0, inicial[v]));
+    }
+    for (int i = 1; i < f->num_ops; i++) anexar_operacao_funcao(&nova, &f->ops[i]);
+
+    free(f->ops);
+    f->ops = nova.ops;
+    f->num_ops = nova.num_ops;
+    f->capacidade = nova.capacidade;
+    return inicial;
+}
+
+/* Insere phis (semi-podadas: só para variáveis lidas em algum bloco antes de
+   serem escritas nele) nas fronteiras de dominância iteradas das definições */
+static void inserir_phis(FormaSSA *ssa, FuncaoILOC *f, int *inicial) {
+    CFG *cfg = ssa->cfg;
+    int n = cfg->num_blocos;
+    int nv = ssa->num_variaveis;
+
+    int *fronteira, *inicio_fronteira;
+    fronteiras_dominancia(cfg, ssa->dom, &fronteira, &inicio_fronteira);
+
+    // Variáveis expostas na entrada de algum bloco e blocos que definem cada uma
+    int *exposta = (int*)calloc(nv + 1, sizeof(int));
+    int *escrita_em = (int*)malloc((nv + 1) * sizeof(int));
+    int *inicio_defs = (int*)calloc(nv + 2, sizeof(int));
+    int *blocos_def = (int*)malloc((cfg->num_blocos * 2 + f->num_ops + 1) * sizeof(int));
+    for (int v = 0; v < nv; v++) escrita_em[v] = -1;
+    for (int passada = 0; passada < 2; passada++) {
+        for (int v = 0; v < nv; v++) escrita_em[v] = -1;
+        for (int b = 0; b < n; b++) {
+            for (int i = cfg->blocos[b].inicio; i <= cfg->blocos[b].fim; i++) {
+                int v = variavel_acessada(&f->ops[i]);
+                if (v < 0) continue;
+                if (f->ops[i].opcode == OP_LOADAI) {
+                    if (escrita_em[v] != b) exposta[v] = 1;
+                } else if (escrita_em[v] != b) {
+                    escrita_em[v] = b;
+                    if (passada == 0) inicio_defs[v + 1]++;
+                    else blocos_def[inicio_defs[v]++] = b;
+                }
+            }
+        }
+        if (passada == 0) {
+            for (int v = 0; v < nv; v++) inicio_defs[v + 1] += inicio_defs[v];
+        } else {
+            for (int v = nv; v > 0; v--) inicio_defs[v] = inicio_defs[v - 1];
+            inicio_defs[0] = 0;
+        }
+    }
+
+    // Fronteira iterada por lista de trabalho; o bloco de entrada também
+    // define as variáveis que ganharam valor inicial
+    int *tem_phi = (int*)malloc((n + 1) * sizeof(int));
+    int *na_lista = (int*)malloc((n + 1) * sizeof(int));
+    int *lista = (int*)malloc((n + 2) * sizeof(int));
+    int cap_phis = 16;
+    ssa->phis = (Phi*)malloc(cap_phis * sizeof(Phi));
+    ssa->num_phis = 0;
+    for (int b = 0; b < n; b++) tem_phi[b] = na_lista[b] = -1;
+
+    for (int v = 0; v < nv; v++) {
+        if (!exposta[v]) continue;
+        int topo = 0;
+        for (int d = inicio_defs[v]; d < inicio_defs[v + 1]; d++) {
+            if (na_lista[blocos_def[d]] != v) {
+                na_lista[blocos_def[d]] = v;
+                lista[topo++] = blocos_def[d];
+            }
+        }
+        if (inicial[v] != REG_NENHUM && na_lista[0] != v) {
+            na_lista[0] = v;
+            lista[topo++] = 0;
+        }
+        while (topo > 0) {
+            int b = lista[--topo];
+            for (int k = inicio_fronteira[b]; k < inicio_fronteira[b + 1]; k++) {
+                int j = fronteira[k];
+                if (tem_phi[j] == v) continue;
+                tem_phi[j] = v;
+
+                if (ssa->num_phis == cap_phis) {
+                    cap_phis *= 2;
+                    ssa->phis = (Phi*)realloc(ssa->phis, cap_phis * sizeof(Phi));
+                }
+                Phi *phi = &ssa->phis[ssa->num_phis++];
+                BlocoBasico *bj = &cfg->blocos[j];
+                phi->bloco = j;
+                phi->variavel = v;
+                phi->destino = novo_temporario(f);
+                phi->num_argumentos = bj->num_predecessores;
+                phi->predecessores = (int*)malloc((bj->num_predecessores + 1) * sizeof(int));
+                phi->argumentos = (int*)malloc((bj->num_predecessores + 1) * sizeof(int));
+                for (int p = 0; p < bj->num_predecessores; p++) {
+                    phi->predecessores[p] = bj->predecessores[p];
+                    phi->argumentos[p] = REG_NENHUM;
+                }
+
+                if (na_lista[j] != v) {
+                    na_lista[j] = v;
+                    lista[topo++] = j;
+                }
+            }
+        }
+    }
+
+    // Agrupa as phis por bloco (ordenação por contagem, estável)
+    ssa->inicio_phis = (int*)calloc(n + 2, sizeof(int));
+    for (int i = 0; i < ssa->num_phis; i++) ssa->inicio_phis[ssa->phis[i].bloco + 1]++;
+    for (int b = 0; b < n; b++) ssa->inicio_phis[b + 1] += ssa->inicio_phis[b];
+    Phi *ordenadas = (Phi*)malloc((ssa->num_phis + 1) * sizeof(Phi));
+    int *preenchidas = (int*)calloc(n + 1, sizeof(int));
+    for (int i = 0; i < ssa->num_phis; i++) {
+        int b = ssa->phis[i].bloco;
+        ordenadas[ssa->inicio_phis[b] + preenchidas[b]++] = ssa->phis[i];
+    }
+    free(ssa->phis);
+    ssa->phis = ordenadas;
+
+    free(preenchidas);
+    free(lista);
+    free(na_lista);
+    free(tem_phi);
+    free(blocos_def);
+    free(inicio_defs);
+    free(escrita_em);
+    free(exposta);
+    free(fronteira);
+    free(inicio_fronteira);
+}
+
+/* Reescreve os operandos lidos pela operação pelos seus substitutos */
+static void substituir_usos(OperacaoILOC *op, int *substituto, int faixa) {
+    for (int k = 0; k < op->num_fonte; k++) {
+        OperandoILOC *o = &op->operandos_fonte[k];
+        int id = o->valor.reg;
+        if (o->tipo == OPERAND_REGISTER && id >= 0 && id < faixa && substituto[id] != REG_NENHUM) {
+            o->valor.reg = substituto[id];
+        }
+    }
+    // store rX => rY lê o endereço em rY
+    if (op->opcode == OP_STORE) {
+        OperandoILOC *o = &op->operandos_alvo[0];
+        int id = o->valor.reg;
+        if (id >= 0 && id < faixa && substituto[id] != REG_NENHUM) o->valor.reg = substituto[id];
+    }
+}
+
+/* Renomeação em pré-ordem na árvore de dominadores. Cada loadAI da variável
+   vira um nop e o temporário que ele definia passa a ser substituído pelo
+   nome corrente; cada storeAI vira um nop e seu valor passa a ser o nome
+   corrente. Os nomes empilhados num bloco são desfeitos ao sair dele. */
+static void renomear(FormaSSA *ssa, FuncaoILOC *f, int *inicial) {
+    CFG *cfg = ssa->cfg;
+    Dominancia *dom = ssa->dom;
+    int n = cfg->num_blocos;
+    int nv = ssa->num_variaveis;
+
+    int faixa = faixa_temporarios(f);
+    int *substituto = (int*)malloc((faixa + 1) * sizeof(int));
+    for (int t = 0; t < faixa; t++) substituto[t] = REG_NENHUM;
+
+    int *nome = (int*)malloc((nv + 1) * sizeof(int));
+    for (int v = 0; v < nv; v++) nome[v] = inicial[v];
+
+    // Registro (variável, nome anterior) para desfazer ao sair do bloco
+    int *registro_var = (int*)malloc((f->num_ops + ssa->num_phis + 1) * sizeof(int));
+    int *registro_nome = (int*)malloc((f->num_ops + ssa->num_phis + 1) * sizeof(int));
+    int num_registros = 0;
+
+    int *pilha = (int*)malloc((n + 1) * sizeof(int));
+    int *marca = (int*)malloc((n + 1) * sizeof(int));
+    int *proximo_filho = (int*)malloc((n + 1) * sizeof(int));
+    int topo = 0;
+    if (n > 0) pilha[topo++] = 0;
+    int entrando = 1;
+
+    while (topo > 0) {
+        int b = pilha[topo - 1];
+        if (entrando) {
+            BlocoBasico *bl = &cfg->blocos[b];
+            marca[b] = num_registros;
+            proximo_filho[b] = dom->inicio_filhos[b];
+
+            for (int p = ssa->inicio_phis[b]; p < ssa->inicio_phis[b + 1]; p++) {
+                Phi *phi = &ssa->phis[p];
+                registro_var[num_registros] = phi->variavel;
+                registro_nome[num_registros++] = nome[phi->variavel];
+                nome[phi->variavel] = phi->destino;
+            }
+
+            for (int i = bl->inicio; i <= bl->fim; i++) {
+                OperacaoILOC *op = &f->ops[i];
+                substituir_usos(op, substituto, faixa);
+                int v = variavel_acessada(op);
+                if (v < 0) continue;
+                if (op->opcode == OP_LOADAI) {
+                    substituto[op->operandos_alvo[0].valor.reg] = nome[v];
+                } else {
+                    registro_var[num_registros] = v;
+                    registro_nome[num_registros++] = nome[v];
+                    nome[v] = op->operandos_fonte[0].valor.reg;
+                }
+                anular_operacao(op);
+            }
+
+            // Argumentos das phis dos sucessores que chegam por este bloco
+            for (int k = 0; k < bl->num_sucessores; k++) {
+                int s = bl->sucessores[k];
+                for (int p = ssa->inicio_phis[s]; p < ssa->inicio_phis[s + 1]; p++) {
+                    Phi *phi = &ssa->phis[p];
+                    for (int a = 0; a < phi->num_argumentos; a++) {
+                        if (phi->predecessores[a] == b) phi->argumentos[a] = nome[phi->variavel];
+                    }
+                }
+            }
+        }
+
+        // Desce para o próximo filho na árvore ou sai do bloco
+        if (proximo_filho[b] < dom->inicio_filhos[b + 1]) {
+            pilha[topo++] = dom->filhos[proximo_filho[b]++];
+            entrando = 1;
+        } else {
+            while (num_registros > marca[b]) {
+                num_registros--;
+                nome[registro_var[num_registros]] = registro_nome[num_registros];
+            }
+            topo--;
+            entrando = 0;
+        }
+    }
+
+    // Blocos inalcançáveis não foram renomeados, mas podem ler temporários substituídos
+    for (int b = 0; b < n; b++) {
+        if (cfg->blocos[b].rpo >= 0) continue;
+        for (int i = cfg->blocos[b].inicio; i <= cfg->blocos[b].fim; i++) {
+            substituir_usos(&f->ops[i], substituto, faixa);
+        }
+    }
+
+    free(proximo_filho);
+    free(marca);
+    free(pilha);
+    free(registro_nome);
+    free(registro_var);
+    free(nome);
+    free(substituto);
+}
+
+FormaSSA* construir_ssa(FuncaoILOC *funcao) {
+    FormaSSA *ssa = (FormaSSA*)calloc(1, sizeof(FormaSSA));
+
+    int nv = 0;
+    for (int i = 0; i < funcao->num_ops; i++) {
+        int v = variavel_acessada(&funcao->ops[i]);
+        if (v + 1 > nv) nv = v + 1;
+    }
+    ssa->num_variaveis = nv;
+
+    int *inicial = inserir_valores_iniciais(funcao, nv);
+    ssa->cfg = construir_cfg(funcao);
+    ssa->dom = calcular_dominancia(ssa->cfg);
+
+    inserir_phis(ssa, funcao, inicial);
+    renomear(ssa, funcao, inicial);
+
+    free(inicial);
+    return ssa;
+}
+
+void atualizar_ssa(FuncaoILOC *funcao, FormaSSA *ssa) {
+    liberar_dominancia(ssa->dom);
+    liberar_cfg(ssa->cfg);
+    ssa->cfg = construir_cfg(funcao);
+    ssa->dom = calcular_dominancia(ssa->cfg);
+}
+
+/* ================================================================= */
+/* ======================== SAÍDA DA SSA =========================== */
+/* ================================================================= */
+
+/* Emite a cópia paralela destinos[i] <- origens[i] como cópias sequenciais.
+   Uma cópia só sai quando ninguém mais precisa ler o valor antigo do seu
+   destino; se sobram apenas ciclos, um temporário extra guarda um dos valores. */
+static void sequencializar(FuncaoILOC *funcao, FuncaoILOC *saida, int *destinos, int *origens, int n) {
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        if (destinos[i] == origens[i]) continue;
+        destinos[k] = destinos[i];
+        origens[k++] = origens[i];
+    }
+    n = k;
+
+    while (n > 0) {
+        int livre = -1;
+        for (int i = 0; i < n && livre < 0; i++) {
+            int lido = 0;
+            for (int j = 0; j < n && !lido; j++) lido = (origens[j] == destinos[i]);
+            if (!lido) livre = i;
+        }
+
+        if (livre < 0) {
+            // Só ciclos: salva o valor de um destino e redireciona quem o lia
+            int salvo = novo_temporario(funcao);
+            anexar_operacao_funcao(saida, criar_i2i(destinos[0], salvo));
+            for (int j = 0; j < n; j++) {
+                if (origens[j] == destinos[0]) origens[j] = salvo;
+            }
+            continue;
+        }
+
+        anexar_operacao_funcao(saida, criar_i2i(origens[livre], destinos[livre]));
+        destinos[livre] = destinos[n - 1];
+        origens[livre] = origens[n - 1];
+        n--;
+    }
+}
+
+void destruir_ssa(FuncaoILOC *funcao, FormaSSA *ssa) {
+    CFG *cfg = construir_cfg(funcao);
+    int n = cfg->num_blocos;
+
+    // Por bloco: cópias antes do desvio final e blocos de aresta dividida logo após ele
+    FuncaoILOC *no_fim = (FuncaoILOC*)calloc(n + 1, sizeof(FuncaoILOC));
+    FuncaoILOC *depois = (FuncaoILOC*)calloc(n + 1, sizeof(FuncaoILOC));
+    int max_phis = 1;
+    for (int b = 0; b < n; b++) {
+        int q = ssa->inicio_phis[b + 1] - ssa->inicio_phis[b];
+        if (q > max_phis) max_phis = q;
+    }
+    int *destinos = (int*)malloc((max_phis + 1) * sizeof(int));
+    int *origens = (int*)malloc((max_phis + 1) * sizeof(int));
+
+    for (int b = 0; b < n && b < ssa->cfg->num_blocos; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        for (int k = 0; k < bl->num_predecessores; k++) {
+            int p = bl->predecessores[k];
+
+            // Cópias vindas da aresta p -> b
+            int num_copias = 0;
+            for (int i = ssa->inicio_phis[b]; i < ssa->inicio_phis[b + 1]; i++) {
+                Phi *phi = &ssa->phis[i];
+                if (phi->destino == REG_NENHUM) continue;
+                for (int a = 0; a < phi->num_argumentos; a++) {
+                    if (phi->predecessores[a] != p || phi->argumentos[a] == REG_NENHUM) continue;
+                    destinos[num_copias] = phi->destino;
+                    origens[num_copias++] = phi->argumentos[a];
+                }
+            }
+            if (num_copias == 0) continue;
+
+            OperacaoILOC *ultima = &funcao->ops[cfg->blocos[p].fim];
+            if (ultima->opcode != OP_CBR) {
+                sequencializar(funcao, &no_fim[p], destinos, origens, num_copias);
+                continue;
+            }
+
+            // Aresta saindo de um cbr: as cópias ganham um bloco próprio
+            int rotulo_alvo = funcao->ops[bl->inicio].rotulo;
+            int rotulo_novo = gerar_rotulo();
+            anexar_operacao_funcao(&depois[p], criar_nop_com_rotulo(rotulo_novo));
+            sequencializar(funcao, &depois[p], destinos, origens, num_copias);
+            anexar_operacao_funcao(&depois[p], criar_jumpI(rotulo_alvo));
+            for (int t = 0; t < 2; t++) {
+                if (ultima->operandos_alvo[t].valor.rotulo == rotulo_alvo) {
+                    ultima->operandos_alvo[t].valor.rotulo = rotulo_novo;
+                }
+            }
+        }
+    }
+
+    // Remonta o vetor com as inserções
+    FuncaoILOC nova = {.nome = funcao->nome};
+    for (int b = 0; b < n; b++) {
+        BlocoBasico *bl = &cfg->blocos[b];
+        Opcode final = funcao->ops[bl->fim].opcode;
+        int desvio_final = (final == OP_JUMPI || final == OP_JUMP || final == OP_CBR || final == OP_RET);
+        int ate = desvio_final ? bl->fim - 1 : bl->fim;
+
+        for (int i = bl->inicio; i <= ate; i++) anexar_operacao_funcao(&nova, &funcao->ops[i]);
+        for (int i = 0; i < no_fim[b].num_ops; i++) anexar_operacao_funcao(&nova, &no_fim[b].ops[i]);
+        if (desvio_final) anexar_operacao_funcao(&nova, &funcao->ops[bl->fim]);
+        for (int i = 0; i < depois[b].num_ops; i++) anexar_operacao_funcao(&nova, &depois[b].ops[i]);
+    }
+    free(funcao->ops);
+    funcao->ops = nova.ops;
+    funcao->num_ops = nova.num_ops;
+    funcao->capacidade = nova.capacidade;
+    compactar_funcao(funcao);
+
+    liberar_funcoes(no_fim, n);
+    liberar_funcoes(depois, n);
+    free(destinos);
+    free(origens);
+    liberar_cfg(cfg);
+
+    for (int i = 0; i < ssa->num_phis; i++) {
+        free(ssa->phis[i].predecessores);
+        free(ssa->phis[i].argumentos);
+    }
+    free(ssa->phis);
+    free(ssa->inicio_phis);
+    liberar_dominancia(ssa->dom);
+    liberar_cfg(ssa->cfg);
+    free(ssa);
+}
@@ -0,0 +1,59 @@
+#ifndef _SSA_H_
+#define _SSA_H_
+
+#include "iloc.h"
+#include "cfg.h"
+#include "dominancia.h"
+
+/* ============================================== */
+/* ================ FORMA SSA =================== */
+/* ============================================== */
+
+/* Os temporários gerados pela semântica já têm uma única definição; quem é
+   redefinido são as variáveis locais (storeAI/loadAI em rfp). A construção
+   promove cada variável local a temporários: storeAI e loadAI viram nops e
+   os usos passam a ler diretamente o valor corrente da variável. Nos pontos
+   de junção, o valor vem de uma phi. */
+
+/* Phi de uma variável no início de um bloco. Os argumentos são indexados pelo
+   bloco predecessor de onde vêm, e não pela posição: passes que removem
+   arestas (um cbr que vira jumpI) não invalidam as phis. */
+typedef struct phi {
+    int bloco;
+    int variavel;           // Índice da variável local promovida
+    int destino;            // Temporário definido pela phi (REG_NENHUM se removida)
+    int num_argumentos;
+    int *predecessores;     // Bloco de origem de cada argumento
+    int *argumentos;        // Temporário que chega por cada predecessor (REG_NENHUM se indefinido)
+} Phi;
+
+typedef struct forma_ssa {
+    CFG *cfg;               // Blocos da função em SSA
+    Dominancia *dom;
+    int num_variaveis;      // Variáveis locais promovidas
+    int num_phis;
+    Phi *phis;              // Agrupadas por bloco
+    int *inicio_phis;       // Por bloco: faixa [inicio_phis[b], inicio_phis[b + 1]) em phis
+} FormaSSA;
+
+/* ============================================== */
+/* ============= FUNÇÕES DA FORMA SSA =========== */
+/* ============================================== */
+
+/* Põe a função em SSA: phis (semi-podadas) nas fronteiras de dominância e
+   renomeação pela árvore de dominadores. Enquanto a função estiver em SSA,
+   os passes só podem reescrever operações no lugar (anular_operacao, trocar
+   operandos, cbr por jumpI), o que mantém a numeração dos blocos. */
+FormaSSA* construir_ssa(FuncaoILOC *funcao);
+
+/* Recalcula o CFG e os dominadores da forma SSA depois de um passe que
+   inseriu operações dentro dos blocos ou removeu arestas. As phis são
+   indexadas por número de bloco, que não muda. */
+void atualizar_ssa(FuncaoILOC *funcao, FormaSSA *ssa);
+
+/* Sai da SSA: cada phi vira uma cópia paralela no fim dos predecessores
+   (arestas críticas são divididas), sequencializada com um temporário
+   extra quando há ciclos. Libera a forma SSA e compacta a função. */
+void destruir_ssa(FuncaoILOC *funcao, FormaSSA *ssa);
+
+#endif // _SSA_H_